@@ -0,0 +1,171 @@
+#!/usr/bin/env python
+# -*- Mode: python; py-indent-offset: 4; indent-tabs-mode: nil; coding: utf-8; -*-
+
+"""Scenario regression benchmarks.
+
+Runs the hub-and-spoke, campus and large scenarios at pinned random seeds over
+a small LossRate/DataRate matrix, collects the METRIC lines they print plus
+the wall time of every run, and compares them against stored baselines:
+
+    ./waf regression                      # or: benchmarks/regression.py
+    ./waf regression --update-baselines   # record new baselines
+
+Run from the top-level directory after ./waf; no network access is needed.
+The simulated metrics are deterministic for a given seed, so any change
+beyond the tolerances below comes from a protocol or simulator change. Wall
+time is noisy and only flagged beyond a wide tolerance. A metric without a
+baseline fails the run as well, unless --update-baselines is given.
+"""
+
+from __future__ import print_function
+
+import argparse
+import itertools
+import json
+import os
+import subprocess
+import sys
+import time
+
+SCENARIOS = {
+    'hub-and-spoke': ['--TotalRunTimeSeconds=40', '--NumOfNodes=10'],
+    'campus': ['--TotalRunTimeSeconds=40'],
+    'large': ['--TotalRunTimeSeconds=30'],
+}
+
+SEEDS = [1, 2]
+LOSS_RATES = [0.0, 0.05]
+DATA_RATES = [1.0, 2.0]
+
+# Compared metrics: (better direction, relative tolerance, absolute tolerance).
+# A change counts if it exceeds both tolerances.
+TOLERANCES = {
+    'delivery_ratio': ('higher', 0.0, 0.01),
+    'delay_p50': ('lower', 0.10, 0.005),
+    'delay_p99': ('lower', 0.15, 0.01),
+    'packets_per_delivery': ('lower', 0.05, 0.1),
+    'sync_interests_per_publish': ('lower', 0.05, 0.1),
+    'wall_time': ('lower', 0.50, 1.0),
+}
+
+
+def case_key(scenario, seed, loss_rate, data_rate):
+    return '%s/LossRate=%g/DataRate=%g/RandomSeed=%d' % (scenario, loss_rate,
+                                                          data_rate, seed)
+
+
+def run_case(build_dir, scenario, seed, loss_rate, data_rate):
+    cmdline = [os.path.join(build_dir, scenario)] + SCENARIOS[scenario] + [
+        '--RandomSeed=%d' % seed,
+        '--LossRate=%g' % loss_rate,
+        '--DataRate=%g' % data_rate,
+    ]
+    start = time.time()
+    process = subprocess.Popen(cmdline, stdout=subprocess.PIPE,
+                               universal_newlines=True)
+    output = process.communicate()[0]
+    wall_time = time.time() - start
+    if process.returncode != 0:
+        raise RuntimeError('%s exited with %d' % (' '.join(cmdline),
+                                                  process.returncode))
+
+    metrics = {'wall_time': wall_time}
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) == 3 and fields[0] == 'METRIC':
+            metrics[fields[1]] = float(fields[2])
+    if len(metrics) == 1:
+        raise RuntimeError('%s printed no METRIC lines' % ' '.join(cmdline))
+    return metrics
+
+
+def compare(name, baseline, current):
+    """Returns 'ok', 'improved' or 'regressed'."""
+    better, relative, absolute = TOLERANCES[name]
+    delta = current - baseline
+    if abs(delta) <= max(relative * abs(baseline), absolute):
+        return 'ok'
+    if (delta > 0) == (better == 'higher'):
+        return 'improved'
+    return 'regressed'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Scenario regression benchmarks')
+    parser.add_argument('--build-dir', default='build',
+                        help='Directory with the scenario binaries')
+    parser.add_argument('--baselines', default='benchmarks/baselines.json',
+                        help='Baseline metrics file')
+    parser.add_argument('--update-baselines', action='store_true', default=False,
+                        help='Store the metrics of this run as the new baselines')
+    parser.add_argument('--output', default='',
+                        help='Also write the metrics of this run to this file')
+    parser.add_argument('scenarios', metavar='scenario', nargs='*',
+                        default=sorted(SCENARIOS),
+                        help='Scenarios to run (default: all)')
+    args = parser.parse_args()
+
+    for scenario in args.scenarios:
+        if scenario not in SCENARIOS:
+            parser.error('unknown scenario %s' % scenario)
+
+    baselines = {}
+    if os.path.exists(args.baselines):
+        with open(args.baselines) as f:
+            baselines = json.load(f)
+    elif not args.update_baselines:
+        # Every metric would lack a baseline, so do not run the matrix only
+        # to fail at the end.
+        print('No baselines in %s; record them on a reference build with'
+              ' --update-baselines and commit the file' % args.baselines)
+        return 1
+
+    results = {}
+    counts = {'ok': 0, 'improved': 0, 'regressed': 0, 'new': 0}
+    for scenario, seed, loss_rate, data_rate in itertools.product(
+            args.scenarios, SEEDS, LOSS_RATES, DATA_RATES):
+        key = case_key(scenario, seed, loss_rate, data_rate)
+        print(key)
+        try:
+            metrics = run_case(args.build_dir, scenario, seed, loss_rate,
+                               data_rate)
+        except (OSError, RuntimeError) as e:
+            print('  ERROR: %s' % e)
+            return 1
+        results[key] = metrics
+
+        baseline = baselines.get(key)
+        for name in sorted(TOLERANCES):
+            if name not in metrics:
+                continue
+            if baseline is None or name not in baseline:
+                verdict = 'new'
+                print('  %-26s %12.6g' % (name, metrics[name]))
+            else:
+                verdict = compare(name, baseline[name], metrics[name])
+                print('  %-26s %12.6g  baseline %12.6g  %s'
+                      % (name, metrics[name], baseline[name], verdict))
+            counts[verdict] += 1
+
+    print('Summary: %(ok)d ok, %(improved)d improved, %(regressed)d regressed,'
+          ' %(new)d without baseline' % counts)
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+
+    if args.update_baselines:
+        baselines.update(results)
+        with open(args.baselines, 'w') as f:
+            json.dump(baselines, f, indent=2, sort_keys=True)
+        print('Baselines written to %s' % args.baselines)
+        return 0
+
+    if counts['new'] > 0:
+        print('Missing baselines; run with --update-baselines to record them')
+        return 1
+    return 1 if counts['regressed'] > 0 else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,187 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Measures the cost of merging a remote sync state into the local one, and
+ * of computing what the remote side is missing, with per-session sequence
+ * numbers kept in a std::map keyed by Name (the layout of a name-keyed sync
+ * state) and in a SessionSeqTable indexed by interned ids:
+ *
+ *     ./build/session-bench [sessions=10000] [rounds=200]
+ *
+ * Both sides start from the same state, then every round a tenth of the
+ * remote sessions publish one more message. The
+ * "interned" variant starts from the decoded session names, as a node does
+ * when a sync reply arrives, and maps them to ids before merging.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "session-table.hpp"
+
+namespace ndn {
+
+namespace {
+
+using NameSeqs = std::vector<std::pair<Name, uint64_t>>;
+
+template <typename Body>
+double Measure(size_t rounds, Body body) {
+  auto start = std::chrono::steady_clock::now();
+  for (size_t round = 0; round < rounds; ++round) body(round);
+  std::chrono::duration<double, std::micro> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / rounds;
+}
+
+// Advances every tenth session of @p remote by one message.
+void Publish(size_t round, NameSeqs* remote) {
+  for (size_t i = round % 10; i < remote->size(); i += 10)
+    ++(*remote)[i].second;
+}
+
+void Print(const char* name, double merge_us) {
+  std::cout << name << ": merge " << merge_us << " us per round" << std::endl;
+}
+
+void Print(const char* name, double merge_us, double diff_us, size_t ranges) {
+  std::cout << name << ": merge " << merge_us << " us, diff " << diff_us
+            << " us per round (" << ranges << " ranges missing)" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  size_t sessions = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000;
+  size_t rounds = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200;
+  if (sessions == 0 || rounds == 0) {
+    std::cerr << "Usage: " << argv[0] << " [sessions] [rounds]" << std::endl;
+    return 1;
+  }
+
+  // Session names as ChronoSync builds them: routing prefix, user prefix and
+  // session number.
+  std::mt19937 rengine(1);
+  NameSeqs remote;
+  for (size_t i = 0; i < sessions; ++i) {
+    Name session("/ndn/site" + std::to_string(i % 100));
+    session.append("Node" + std::to_string(i)).appendNumber(rengine());
+    remote.push_back(std::make_pair(session, 1 + rengine() % 100));
+  }
+
+  // Name-keyed state. The remote state is a map too, so that the diff walks
+  // two name-keyed containers.
+  {
+    NameSeqs input = remote;
+    std::map<Name, uint64_t> local(input.begin(), input.end());
+    std::map<Name, uint64_t> theirs;
+    std::vector<std::tuple<Name, uint64_t, uint64_t>> updates;
+    double merge_us = Measure(rounds, [&](size_t round) {
+      Publish(round, &input);
+      updates.clear();
+      for (const auto& entry : input) {
+        auto it = local.find(entry.first);
+        if (it == local.end()) {
+          local.insert(entry);
+          updates.emplace_back(entry.first, 1, entry.second);
+        } else if (it->second < entry.second) {
+          updates.emplace_back(entry.first, it->second + 1, entry.second);
+          it->second = entry.second;
+        }
+      }
+    });
+
+    for (size_t i = 0; i < input.size(); ++i)
+      theirs[input[i].first] = input[i].second - (i % 7 == 0);
+    std::vector<std::tuple<Name, uint64_t, uint64_t>> missing;
+    double diff_us = Measure(rounds, [&](size_t) {
+      missing.clear();
+      for (const auto& entry : local) {
+        auto it = theirs.find(entry.first);
+        uint64_t seq = it == theirs.end() ? 0 : it->second;
+        if (entry.second > seq)
+          missing.emplace_back(entry.first, seq + 1, entry.second);
+      }
+    });
+    Print("std::map<Name>", merge_us, diff_us, missing.size());
+  }
+
+  // Interned: names are looked up in the session table, the state is flat.
+  {
+    NameSeqs input = remote;
+    SessionTable table;
+    SessionSeqTable local;
+    for (const auto& entry : input)
+      local.Update(table.Intern(entry.first), entry.second);
+    std::vector<SessionSeqRange> updates;
+    double merge_us = Measure(rounds, [&](size_t round) {
+      Publish(round, &input);
+      updates.clear();
+      SessionSeqRange covered;
+      for (const auto& entry : input) {
+        if (local.Update(table.Intern(entry.first), entry.second, &covered))
+          updates.push_back(covered);
+      }
+    });
+    Print("SessionTable+SessionSeqTable", merge_us);
+  }
+
+  // Ids only: both states are already in id space.
+  {
+    NameSeqs input = remote;
+    SessionSeqTable local;
+    SessionSeqTable incoming;
+    for (size_t i = 0; i < input.size(); ++i) {
+      local.Update(static_cast<SessionId>(i), input[i].second);
+      incoming.Update(static_cast<SessionId>(i), input[i].second);
+    }
+    std::vector<SessionSeqRange> updates;
+    double merge_us = Measure(rounds, [&](size_t round) {
+      Publish(round, &input);
+      for (size_t i = round % 10; i < input.size(); i += 10)
+        incoming.Update(static_cast<SessionId>(i), input[i].second);
+      updates.clear();
+      local.Merge(incoming, &updates);
+    });
+
+    SessionSeqTable theirs;
+    for (size_t i = 0; i < input.size(); ++i)
+      theirs.Update(static_cast<SessionId>(i), input[i].second - (i % 7 == 0));
+    std::vector<SessionSeqRange> missing;
+    double diff_us = Measure(rounds, [&](size_t) {
+      missing.clear();
+      local.Diff(theirs, &missing);
+    });
+    Print("SessionSeqTable", merge_us, diff_us, missing.size());
+  }
+  return 0;
+}
+
+}  // namespace ndn
+
+int main(int argc, char* argv[]) { return ndn::main(argc, argv); }
@@ -0,0 +1,196 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Compares the cost of re-arming node timers through ndn::Scheduler, the way
+ * ChronoSyncNode used to, with the SchedulerTimerWheel it uses now:
+ *
+ *     ./build/timer-bench [seconds-per-case=2] [timers...]
+ *
+ * Both sides run on an io_service in wall-clock time, so the wheel pays for
+ * its scheduler wakeups exactly as in the node. Every timer re-arms itself
+ * from its own callback with a delay of 1 to 10 ms, like the publish and
+ * fetch retry timers. By default it runs 1, 16, 1024 and 10000 concurrent
+ * timers and reports CPU time and heap allocations per fired timer, plus
+ * fired timers per scheduler wakeup.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <new>
+#include <random>
+#include <vector>
+
+#include <ndn-cxx/util/scheduler.hpp>
+
+#include "scheduler-timer-wheel.hpp"
+
+namespace {
+
+std::atomic<uint64_t> g_allocations(0);
+
+}  // namespace
+
+void* operator new(size_t size) {
+  ++g_allocations;
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace ndn {
+
+namespace {
+
+struct Result {
+  uint64_t events;
+  uint64_t wakeups;
+  double cpu_seconds;
+  uint64_t allocations;
+};
+
+class SchedulerBench {
+ public:
+  explicit SchedulerBench(size_t timers)
+      : scheduler_(io_service_), rdist_(1, 10) {
+    for (size_t i = 0; i < timers; ++i) Rearm();
+  }
+
+  Result Run(time::milliseconds duration) {
+    uint64_t allocations = g_allocations;
+    std::clock_t start = std::clock();
+    scheduler_.scheduleEvent(duration, [this] { io_service_.stop(); });
+    io_service_.run();
+    double cpu = static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+    return Result{fired_, fired_, cpu, g_allocations - allocations};
+  }
+
+ private:
+  void Rearm() {
+    scheduler_.scheduleEvent(time::milliseconds(rdist_(rengine_)),
+                             std::bind(&SchedulerBench::Fire, this));
+  }
+
+  void Fire() {
+    ++fired_;
+    Rearm();
+  }
+
+  boost::asio::io_service io_service_;
+  Scheduler scheduler_;
+  std::mt19937 rengine_;
+  std::uniform_int_distribution<int> rdist_;
+  uint64_t fired_ = 0;
+};
+
+class WheelBench {
+ public:
+  explicit WheelBench(size_t timers)
+      : scheduler_(io_service_),
+        timers_(scheduler_),
+        entries_(timers),
+        rdist_(1, 10) {
+    for (TimerEntry& entry : entries_) {
+      TimerEntry* e = &entry;
+      entry.SetCallback([this, e] { Fire(*e); });
+      Rearm(entry);
+    }
+  }
+
+  Result Run(time::milliseconds duration) {
+    uint64_t allocations = g_allocations;
+    std::clock_t start = std::clock();
+    scheduler_.scheduleEvent(duration, [this] { io_service_.stop(); });
+    io_service_.run();
+    double cpu = static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+    return Result{fired_, timers_.GetWakeups(), cpu,
+                  g_allocations - allocations};
+  }
+
+ private:
+  void Rearm(TimerEntry& entry) {
+    timers_.Schedule(entry, time::milliseconds(rdist_(rengine_)));
+  }
+
+  void Fire(TimerEntry& entry) {
+    ++fired_;
+    Rearm(entry);
+  }
+
+  boost::asio::io_service io_service_;
+  Scheduler scheduler_;
+  // Declared before the entries so that it outlives them.
+  SchedulerTimerWheel timers_;
+  std::vector<TimerEntry> entries_;
+  std::mt19937 rengine_;
+  std::uniform_int_distribution<int> rdist_;
+  uint64_t fired_ = 0;
+};
+
+void Print(const char* name, size_t timers, const Result& result) {
+  double events = std::max<double>(result.events, 1);
+  double wakeups = std::max<double>(result.wakeups, 1);
+  std::cout << name << ", " << timers << " timers: " << result.events
+            << " events, " << result.cpu_seconds * 1e6 / events
+            << " us CPU/event, " << result.allocations / events
+            << " allocations/event, " << result.events / wakeups
+            << " events/wakeup" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  double seconds = argc > 1 ? std::strtod(argv[1], nullptr) : 2.0;
+  std::vector<size_t> timer_counts;
+  for (int i = 2; i < argc; ++i)
+    timer_counts.push_back(std::strtoul(argv[i], nullptr, 10));
+  if (timer_counts.empty()) timer_counts = {1, 16, 1024, 10000};
+  if (seconds <= 0.0 || std::count(timer_counts.begin(), timer_counts.end(),
+                                   size_t(0)) != 0) {
+    std::cerr << "Usage: " << argv[0] << " [seconds-per-case] [timers...]"
+              << std::endl;
+    return 1;
+  }
+
+  time::milliseconds duration(static_cast<int64_t>(seconds * 1000));
+  for (size_t timers : timer_counts) {
+    {
+      SchedulerBench bench(timers);
+      Print("Scheduler", timers, bench.Run(duration));
+    }
+    {
+      WheelBench bench(timers);
+      Print("SchedulerTimerWheel", timers, bench.Run(duration));
+    }
+  }
+  return 0;
+}
+
+}  // namespace ndn
+
+int main(int argc, char* argv[]) { return ndn::main(argc, argv); }
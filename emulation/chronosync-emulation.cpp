@@ -0,0 +1,214 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Runs many ChronoSyncNode instances in one process on wall-clock time,
+ * connected by a LoopbackForwarder, to measure the real CPU cost of the sync
+ * logic:
+ *
+ *     ./build/chronosync-emulation --NumOfNodes=50 --DataRate=5 \
+ *         --RunTimeSeconds=30 --LinkDelay=10 --LossRate=0.01 --Threads=4
+ *
+ * With --Threads > 1 the nodes are spread over a work-stealing thread pool;
+ * each node still runs on one thread at a time. Interest nonces then come
+ * from per-thread engines, see thread-local-random.hpp.
+ *
+ * Built only when configured with ./waf configure --with-emulation, against a
+ * regular (non-ndnSIM) installation of ndn-cxx.
+ */
+
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "chronosync-node.hpp"
+#include "loopback-forwarder.hpp"
+#include "node-thread-pool.hpp"
+#include "thread-local-random.hpp"
+
+namespace ndn {
+
+namespace {
+
+struct Options {
+  size_t num_of_nodes = 10;
+  double data_rate = 1.0;
+  uint64_t max_messages = 100;
+  double run_time_seconds = 30.0;
+  int64_t link_delay_ms = 10;
+  double loss_rate = 0.0;
+  uint32_t seed = 1;
+  std::string retry_policy = "fixed";
+  size_t threads = 1;
+};
+
+bool ParseOptions(int argc, char* argv[], Options* options) {
+  std::map<std::string, std::string> values;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg(argv[i]);
+    size_t eq = arg.find('=');
+    if (arg.compare(0, 2, "--") != 0 || eq == std::string::npos) return false;
+    values[arg.substr(2, eq - 2)] = arg.substr(eq + 1);
+  }
+
+  for (const auto& v : values) {
+    const char* value = v.second.c_str();
+    if (v.first == "NumOfNodes")
+      options->num_of_nodes = std::strtoul(value, nullptr, 10);
+    else if (v.first == "DataRate")
+      options->data_rate = std::atof(value);
+    else if (v.first == "MaxMessages")
+      options->max_messages = std::strtoull(value, nullptr, 10);
+    else if (v.first == "RunTimeSeconds")
+      options->run_time_seconds = std::atof(value);
+    else if (v.first == "LinkDelay")
+      options->link_delay_ms = std::strtoll(value, nullptr, 10);
+    else if (v.first == "LossRate")
+      options->loss_rate = std::atof(value);
+    else if (v.first == "RandomSeed")
+      options->seed = std::strtoul(value, nullptr, 10);
+    else if (v.first == "RetryPolicy")
+      options->retry_policy = v.second;
+    else if (v.first == "Threads")
+      options->threads = std::strtoul(value, nullptr, 10);
+    else
+      return false;
+  }
+  return options->num_of_nodes > 1 && options->threads > 0;
+}
+
+void PrintUsage(const char* program) {
+  std::cerr << "Usage: " << program << " [--NumOfNodes=10] [--DataRate=1.0]"
+            << " [--MaxMessages=100] [--RunTimeSeconds=30] [--LinkDelay=10]"
+            << " [--LossRate=0.0] [--RandomSeed=1] [--RetryPolicy=fixed]"
+            << " [--Threads=1]" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  Options options;
+  FetchRetryPolicy policy;
+  if (!ParseOptions(argc, argv, &options) ||
+      !FetchRetryPolicy::ParseKind(options.retry_policy, &policy.kind)) {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+  if (options.threads > 1 && !IsRandomThreadLocal()) {
+    std::cerr << "--Threads > 1 needs Interest nonces from per-thread engines,"
+              << " but this ndn-cxx does not call the emulation's"
+              << " random::generateWord32(); link against a shared libndn-cxx"
+              << " or use --Threads=1" << std::endl;
+    return 1;
+  }
+
+  // KeyChain is not thread-safe, so with several threads every node signs
+  // with its own instance.
+  std::vector<std::unique_ptr<KeyChain>> keychains;
+  keychains.emplace_back(new KeyChain());
+  LoopbackForwarder forwarder(time::milliseconds(options.link_delay_ms),
+                              options.loss_rate, options.seed);
+
+  // Counters are per node, since only the thread running a node updates them.
+  std::vector<uint64_t> published(options.num_of_nodes, 0);
+  std::vector<uint64_t> delivered(options.num_of_nodes, 0);
+  std::vector<std::unique_ptr<ChronoSyncNode>> nodes;
+  for (size_t i = 0; i < options.num_of_nodes; ++i) {
+    if (options.threads > 1 && i > 0) keychains.emplace_back(new KeyChain());
+    KeyChain& keychain = *keychains.back();
+
+    std::string user_prefix = "/Node" + std::to_string(i + 1);
+    nodes.emplace_back(new ChronoSyncNode(
+        options.seed + i, Name("/ndn/broadcast/sync"), Name(user_prefix),
+        Name("/"), keychain, options.data_rate, policy,
+        forwarder.AddNode(keychain)));
+    nodes.back()->SetMaxMessages(options.max_messages);
+    uint64_t* node_published = &published[i];
+    uint64_t* node_delivered = &delivered[i];
+    nodes.back()->ConnectDataEventTrace(
+        [node_published, node_delivered](const std::string&, bool is_local) {
+          ++*(is_local ? node_published : node_delivered);
+        });
+    nodes.back()->Init();
+    nodes.back()->Run();
+  }
+
+  NodeThreadPool pool(options.threads, nodes.size());
+
+  std::clock_t cpu_start = std::clock();
+  auto start = time::steady_clock::now();
+  auto end = start + time::nanoseconds(
+                         static_cast<int64_t>(options.run_time_seconds * 1e9));
+
+  pool.Run(
+      [&forwarder, &nodes](size_t i) {
+        size_t handled =
+            forwarder.GetTransport(i).DeliverDue(time::steady_clock::now());
+        handled += nodes[i]->GetIoService().poll();
+        nodes[i]->GetIoService().reset();
+        return handled;
+      },
+      end);
+
+  // std::clock() is the CPU time of the whole process, i.e. of all threads.
+  double wall = time::duration_cast<time::microseconds>(
+                    time::steady_clock::now() - start).count() / 1e6;
+  double cpu = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+  uint64_t total_published = 0;
+  uint64_t total_delivered = 0;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    total_published += published[i];
+    total_delivered += delivered[i];
+  }
+  uint64_t expected = total_published * (options.num_of_nodes - 1);
+
+  std::cout << "Nodes/threads: " << options.num_of_nodes << "/"
+            << options.threads << " (" << pool.GetSteals() << " steals)"
+            << std::endl;
+  std::cout << "Total number of data published is: " << total_published
+            << std::endl;
+  std::cout << "Total number of data propagated is: " << total_delivered
+            << " of " << expected << " expected" << std::endl;
+  std::cout << "Packets forwarded/lost: " << forwarder.GetSentPackets() << "/"
+            << forwarder.GetLostPackets() << std::endl;
+  std::cout << "Wall/CPU time: " << wall << "/" << cpu << " seconds"
+            << std::endl;
+  if (cpu > 0.0) {
+    std::cout << "Publishes per CPU second: " << total_published / cpu
+              << std::endl;
+    std::cout << "Deliveries per CPU second: " << total_delivered / cpu
+              << std::endl;
+  }
+  if (wall > 0.0) {
+    std::cout << "Deliveries per second per thread: "
+              << total_delivered / wall / options.threads << std::endl;
+  }
+
+  nodes.clear();
+  return 0;
+}
+
+}  // namespace ndn
+
+int main(int argc, char* argv[]) { return ndn::main(argc, argv); }
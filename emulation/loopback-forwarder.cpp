@@ -0,0 +1,257 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "loopback-forwarder.hpp"
+
+#include <algorithm>
+
+#include <ndn-cxx/data.hpp>
+#include <ndn-cxx/management/nfd-control-parameters.hpp>
+#include <ndn-cxx/management/nfd-control-response.hpp>
+
+namespace ndn {
+
+namespace {
+
+const Name kLocalhostPrefix("/localhost");
+
+// Expired PIT records are purged after this many insertions.
+const size_t kPitPurgeInterval = 1024;
+
+// Initial capacity of the lock-free incoming queue; it grows on demand.
+const size_t kIncomingQueueCapacity = 256;
+
+}  // namespace
+
+LoopbackTransport::LoopbackTransport(LoopbackForwarder& forwarder, size_t id,
+                                     KeyChain& keychain)
+    : forwarder_(forwarder),
+      id_(id),
+      key_chain_(keychain),
+      rengine_(forwarder.seed_ + id),
+      incoming_(kIncomingQueueCapacity) {}
+
+LoopbackTransport::~LoopbackTransport() {
+  Packet* packet;
+  while (incoming_.pop(packet)) delete packet;
+  while (!inbox_.empty()) {
+    delete inbox_.top();
+    inbox_.pop();
+  }
+}
+
+void LoopbackTransport::connect(boost::asio::io_service& io_service,
+                                const ReceiveCallback& receive_callback) {
+  Transport::connect(io_service, receive_callback);
+  m_isConnected = true;
+  m_isReceiving = true;
+}
+
+void LoopbackTransport::close() {
+  m_isConnected = false;
+  m_isReceiving = false;
+}
+
+void LoopbackTransport::pause() { m_isReceiving = false; }
+
+void LoopbackTransport::resume() { m_isReceiving = true; }
+
+void LoopbackTransport::send(const Block& wire) {
+  if (wire.type() == tlv::Interest) {
+    Interest interest(wire);
+    if (kLocalhostPrefix.isPrefixOf(interest.getName()))
+      ProcessCommand(interest);
+    else
+      forwarder_.ForwardInterest(*this, interest, wire);
+    return;
+  }
+
+  if (wire.type() != tlv::Data) return;
+
+  Data data(wire);
+  const Name& name = data.getName();
+  auto now = time::steady_clock::now();
+  for (size_t k = 0; k <= name.size(); ++k) {
+    auto range = pit_.equal_range(name.getPrefix(k));
+    for (auto it = range.first; it != range.second;) {
+      if (it->second.expiry >= now)
+        forwarder_.ForwardData(*this, it->second.requester, wire);
+      it = pit_.erase(it);
+    }
+  }
+}
+
+void LoopbackTransport::send(const Block& header, const Block& payload) {
+  Buffer buffer(header.begin(), header.end());
+  buffer.insert(buffer.end(), payload.begin(), payload.end());
+  send(Block(buffer.buf(), buffer.size()));
+}
+
+size_t LoopbackTransport::DeliverDue(time::steady_clock::TimePoint now) {
+  Packet* packet;
+  while (incoming_.pop(packet)) inbox_.push(packet);
+
+  size_t delivered = 0;
+  while (!inbox_.empty() && inbox_.top()->due <= now) {
+    std::unique_ptr<Packet> due(inbox_.top());
+    inbox_.pop();
+    Receive(*due);
+    ++delivered;
+  }
+  return delivered;
+}
+
+void LoopbackTransport::Enqueue(time::steady_clock::TimePoint due, size_t from,
+                                const Block& wire) {
+  incoming_.push(new Packet{due, from, wire});
+}
+
+void LoopbackTransport::Receive(const Packet& packet) {
+  if (!m_isConnected) return;
+  if (packet.wire.type() == tlv::Interest && packet.from != id_)
+    RecordInterest(Interest(packet.wire), packet.from);
+  m_receiveCallback(packet.wire);
+}
+
+void LoopbackTransport::RecordInterest(const Interest& interest,
+                                       size_t requester) {
+  auto now = time::steady_clock::now();
+  time::milliseconds lifetime = interest.getInterestLifetime();
+  if (lifetime < time::milliseconds::zero())
+    lifetime = DEFAULT_INTEREST_LIFETIME;
+
+  auto range = pit_.equal_range(interest.getName());
+  auto it = std::find_if(range.first, range.second,
+                         [requester](const std::pair<const Name, PitRecord>& r) {
+                           return r.second.requester == requester;
+                         });
+  if (it != range.second) {
+    it->second.expiry = now + lifetime;
+    return;
+  }
+  pit_.insert(std::make_pair(interest.getName(),
+                             PitRecord{requester, now + lifetime}));
+
+  if (++pit_inserts_ % kPitPurgeInterval == 0) PurgeExpiredPit(now);
+}
+
+void LoopbackTransport::PurgeExpiredPit(time::steady_clock::TimePoint now) {
+  for (auto it = pit_.begin(); it != pit_.end();) {
+    if (it->second.expiry < now)
+      it = pit_.erase(it);
+    else
+      ++it;
+  }
+}
+
+// Answers NFD management commands as NFD would, so that prefix registration
+// through Face::setInterestFilter() succeeds.
+void LoopbackTransport::ProcessCommand(const Interest& interest) {
+  const Name& name = interest.getName();
+  nfd::ControlResponse response(200, "OK");
+
+  if (name.size() > 4) {
+    nfd::ControlParameters params(name[4].blockFromValue());
+    params.setFaceId(id_ + 1);
+    if (name[2] == name::Component("rib") &&
+        name[3] == name::Component("register"))
+      forwarder_.Register(id_, params.getName());
+    response.setBody(params.wireEncode());
+  }
+
+  Data data(name);
+  data.setContent(response.wireEncode());
+  key_chain_.signWithSha256(data);
+  Enqueue(time::steady_clock::now(), id_, data.wireEncode());
+}
+
+LoopbackForwarder::LoopbackForwarder(time::nanoseconds delay, double loss_rate,
+                                     uint32_t seed)
+    : delay_(delay),
+      loss_rate_(loss_rate),
+      seed_(seed),
+      fib_(std::make_shared<Fib>()) {}
+
+shared_ptr<LoopbackTransport> LoopbackForwarder::AddNode(KeyChain& keychain) {
+  auto transport =
+      make_shared<LoopbackTransport>(*this, transports_.size(), keychain);
+  transports_.push_back(transport);
+  return transport;
+}
+
+uint64_t LoopbackForwarder::GetSentPackets() const {
+  uint64_t sent = 0;
+  for (const auto& transport : transports_) sent += transport->sent_;
+  return sent;
+}
+
+uint64_t LoopbackForwarder::GetLostPackets() const {
+  uint64_t lost = 0;
+  for (const auto& transport : transports_) lost += transport->lost_;
+  return lost;
+}
+
+void LoopbackForwarder::Register(size_t node, const Name& prefix) {
+  std::lock_guard<std::mutex> lock(fib_mutex_);
+  auto entry = std::make_pair(prefix, node);
+  if (std::find(fib_->begin(), fib_->end(), entry) != fib_->end()) return;
+
+  auto fib = std::make_shared<Fib>(*fib_);
+  fib->push_back(entry);
+  std::atomic_store(&fib_, std::shared_ptr<const Fib>(fib));
+}
+
+void LoopbackForwarder::ForwardInterest(LoopbackTransport& from,
+                                        const Interest& interest,
+                                        const Block& wire) {
+  std::shared_ptr<const Fib> fib = std::atomic_load(&fib_);
+  std::vector<size_t> targets;
+  for (const auto& entry : *fib) {
+    if (entry.second != from.id_ && entry.first.isPrefixOf(interest.getName()))
+      targets.push_back(entry.second);
+  }
+  std::sort(targets.begin(), targets.end());
+  targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+
+  auto due = time::steady_clock::now() + delay_;
+  std::bernoulli_distribution loss(loss_rate_);
+  for (size_t to : targets) {
+    ++from.sent_;
+    if (loss(from.rengine_)) {
+      ++from.lost_;
+      continue;
+    }
+    transports_[to]->Enqueue(due, from.id_, wire);
+  }
+}
+
+void LoopbackForwarder::ForwardData(LoopbackTransport& from, size_t to,
+                                    const Block& wire) {
+  ++from.sent_;
+  std::bernoulli_distribution loss(loss_rate_);
+  if (loss(from.rengine_)) {
+    ++from.lost_;
+    return;
+  }
+  transports_[to]->Enqueue(time::steady_clock::now() + delay_, from.id_, wire);
+}
+
+}  // namespace ndn
@@ -0,0 +1,181 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOOPBACK_FORWARDER_HPP_
+#define LOOPBACK_FORWARDER_HPP_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include <boost/lockfree/queue.hpp>
+
+#include <ndn-cxx/interest.hpp>
+#include <ndn-cxx/security/key-chain.hpp>
+#include <ndn-cxx/transport/transport.hpp>
+#include <ndn-cxx/util/time.hpp>
+
+namespace ndn {
+
+class LoopbackForwarder;
+
+/**
+ * Face transport of one node attached to a LoopbackForwarder.
+ *
+ * Outgoing packets are handed to the forwarder; incoming packets wait in the
+ * node's inbox until their delivery time and are passed to the face by
+ * DeliverDue(). NFD management commands (prefix registration) are answered
+ * locally. The transport also keeps the PIT state of its node's incoming
+ * Interests, so that Data sent by the node goes back to the requesters.
+ *
+ * Apart from Enqueue(), which any node may call, a transport is only used
+ * by the thread currently running its node. Enqueue() pushes into a
+ * lock-free multi-producer queue that DeliverDue() drains into a
+ * thread-private heap ordered by delivery time.
+ */
+class LoopbackTransport : public Transport {
+ public:
+  LoopbackTransport(LoopbackForwarder& forwarder, size_t id,
+                    KeyChain& keychain);
+
+  virtual ~LoopbackTransport();
+
+  virtual void connect(boost::asio::io_service& io_service,
+                       const ReceiveCallback& receive_callback);
+
+  virtual void close();
+
+  virtual void pause();
+
+  virtual void resume();
+
+  virtual void send(const Block& wire);
+
+  virtual void send(const Block& header, const Block& payload);
+
+  // Passes all inbox packets due at @p now to the face. Returns the number of
+  // packets delivered.
+  size_t DeliverDue(time::steady_clock::TimePoint now);
+
+  size_t GetId() const { return id_; }
+
+  uint64_t GetSentPackets() const { return sent_; }
+
+  uint64_t GetLostPackets() const { return lost_; }
+
+ private:
+  friend class LoopbackForwarder;
+
+  struct Packet {
+    time::steady_clock::TimePoint due;
+    size_t from;
+    Block wire;
+  };
+
+  struct LaterDue {
+    bool operator()(const Packet* a, const Packet* b) const {
+      return a->due > b->due;
+    }
+  };
+
+  struct PitRecord {
+    size_t requester;
+    time::steady_clock::TimePoint expiry;
+  };
+
+  void Enqueue(time::steady_clock::TimePoint due, size_t from,
+               const Block& wire);
+
+  void Receive(const Packet& packet);
+
+  void RecordInterest(const Interest& interest, size_t requester);
+
+  void PurgeExpiredPit(time::steady_clock::TimePoint now);
+
+  void ProcessCommand(const Interest& interest);
+
+  LoopbackForwarder& forwarder_;
+  size_t id_;
+  KeyChain& key_chain_;
+  std::mt19937 rengine_;
+
+  boost::lockfree::queue<Packet*> incoming_;
+  std::priority_queue<Packet*, std::vector<Packet*>, LaterDue> inbox_;
+  std::multimap<Name, PitRecord> pit_;
+  size_t pit_inserts_ = 0;
+
+  uint64_t sent_ = 0;
+  uint64_t lost_ = 0;
+};
+
+/**
+ * In-memory stand-in for NFD connecting many ChronoSyncNode instances in one
+ * process. Every hop has the same delay and independent loss.
+ *
+ * Interests are multicast to every other node that registered a matching
+ * prefix; Data follows the PIT of the producing node back to the requesters.
+ * Nodes may run on different threads: the FIB is an immutable snapshot
+ * replaced on registration, and packet counters live in the sending
+ * transport.
+ */
+class LoopbackForwarder {
+ public:
+  LoopbackForwarder(time::nanoseconds delay, double loss_rate, uint32_t seed);
+
+  shared_ptr<LoopbackTransport> AddNode(KeyChain& keychain);
+
+  size_t GetNodeCount() const { return transports_.size(); }
+
+  LoopbackTransport& GetTransport(size_t id) { return *transports_[id]; }
+
+  // Only meaningful once no node is running.
+  uint64_t GetSentPackets() const;
+
+  uint64_t GetLostPackets() const;
+
+ private:
+  friend class LoopbackTransport;
+
+  using Fib = std::vector<std::pair<Name, size_t>>;
+
+  void Register(size_t node, const Name& prefix);
+
+  void ForwardInterest(LoopbackTransport& from, const Interest& interest,
+                       const Block& wire);
+
+  void ForwardData(LoopbackTransport& from, size_t to, const Block& wire);
+
+  time::nanoseconds delay_;
+  double loss_rate_;
+  uint32_t seed_;
+
+  std::vector<shared_ptr<LoopbackTransport>> transports_;
+
+  std::mutex fib_mutex_;
+  std::shared_ptr<const Fib> fib_;
+};
+
+}  // namespace ndn
+
+#endif  // LOOPBACK_FORWARDER_HPP_
@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "node-thread-pool.hpp"
+
+#include <chrono>
+#include <thread>
+
+namespace ndn {
+
+NodeThreadPool::NodeThreadPool(size_t num_threads, size_t num_nodes) {
+  for (size_t i = 0; i < num_threads; ++i)
+    workers_.emplace_back(new Worker());
+  for (size_t node = 0; node < num_nodes; ++node)
+    workers_[node % num_threads]->nodes.push_back(node);
+}
+
+void NodeThreadPool::Run(const Slice& slice,
+                         time::steady_clock::TimePoint end) {
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < workers_.size(); ++i)
+    threads.emplace_back(&NodeThreadPool::WorkerLoop, this, i, std::cref(slice),
+                         end);
+  WorkerLoop(0, slice, end);
+  for (auto& thread : threads) thread.join();
+}
+
+uint64_t NodeThreadPool::GetSteals() const {
+  uint64_t steals = 0;
+  for (const auto& worker : workers_) steals += worker->steals;
+  return steals;
+}
+
+bool NodeThreadPool::Pop(Worker& worker, size_t* node) {
+  std::lock_guard<std::mutex> lock(worker.mutex);
+  if (worker.nodes.empty()) return false;
+  *node = worker.nodes.front();
+  worker.nodes.pop_front();
+  return true;
+}
+
+void NodeThreadPool::Push(Worker& worker, size_t node) {
+  std::lock_guard<std::mutex> lock(worker.mutex);
+  worker.nodes.push_back(node);
+}
+
+bool NodeThreadPool::Steal(size_t thief, size_t* node) {
+  for (size_t i = 1; i < workers_.size(); ++i) {
+    Worker& victim = *workers_[(thief + i) % workers_.size()];
+    if (!victim.busy.load(std::memory_order_relaxed)) continue;
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    // Leave the victim at least one node so that it does not start stealing
+    // right back.
+    if (victim.nodes.size() > 1) {
+      *node = victim.nodes.back();
+      victim.nodes.pop_back();
+      ++workers_[thief]->steals;
+      return true;
+    }
+  }
+  return false;
+}
+
+void NodeThreadPool::WorkerLoop(size_t id, const Slice& slice,
+                                time::steady_clock::TimePoint end) {
+  Worker& self = *workers_[id];
+  size_t idle_slices = 0;
+
+  while (time::steady_clock::now() < end) {
+    size_t node;
+    if (!Pop(self, &node)) {
+      if (!Steal(id, &node)) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        continue;
+      }
+    }
+
+    bool busy = slice(node) > 0;
+    self.busy.store(busy, std::memory_order_relaxed);
+    if (busy)
+      idle_slices = 0;
+    else
+      ++idle_slices;
+    Push(self, node);
+
+    size_t own_nodes;
+    {
+      std::lock_guard<std::mutex> lock(self.mutex);
+      own_nodes = self.nodes.size();
+    }
+    if (idle_slices >= own_nodes) {
+      size_t stolen;
+      if (Steal(id, &stolen))
+        Push(self, stolen);
+      else
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+      idle_slices = 0;
+    }
+  }
+}
+
+}  // namespace ndn
@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NODE_THREAD_POOL_HPP_
+#define NODE_THREAD_POOL_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <ndn-cxx/util/time.hpp>
+
+namespace ndn {
+
+/**
+ * Runs node slices on a fixed set of threads with work stealing.
+ *
+ * Every node id sits in exactly one worker deque, except while a worker runs
+ * a slice of it, so a node is never run by two threads at once. A worker
+ * takes nodes from the front of its own deque and puts them back at the
+ * end. After a full pass in which none of its nodes had work, it steals a
+ * node from the back of the deque of a worker whose last slice was busy, so
+ * nodes drift from overloaded workers to idle ones.
+ */
+class NodeThreadPool {
+ public:
+  // Runs one slice of node @p node and returns the number of handled events.
+  using Slice = std::function<size_t(size_t node)>;
+
+  NodeThreadPool(size_t num_threads, size_t num_nodes);
+
+  // Runs slices until @p end; blocks the calling thread.
+  void Run(const Slice& slice, time::steady_clock::TimePoint end);
+
+  uint64_t GetSteals() const;
+
+ private:
+  struct Worker {
+    std::mutex mutex;
+    std::deque<size_t> nodes;
+    std::atomic<bool> busy{false};
+    uint64_t steals = 0;
+  };
+
+  bool Pop(Worker& worker, size_t* node);
+
+  void Push(Worker& worker, size_t node);
+
+  bool Steal(size_t thief, size_t* node);
+
+  void WorkerLoop(size_t id, const Slice& slice,
+                  time::steady_clock::TimePoint end);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+};
+
+}  // namespace ndn
+
+#endif  // NODE_THREAD_POOL_HPP_
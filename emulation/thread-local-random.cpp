@@ -0,0 +1,62 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "thread-local-random.hpp"
+
+#include <cstdint>
+#include <random>
+
+#include <ndn-cxx/interest.hpp>
+#include <ndn-cxx/util/random.hpp>
+
+namespace ndn {
+
+namespace {
+
+thread_local uint64_t calls = 0;
+
+std::mt19937_64& GetEngine() {
+  thread_local std::mt19937_64 engine(std::random_device{}());
+  ++calls;
+  return engine;
+}
+
+}  // namespace
+
+// These interpose the definitions in libndn-cxx, which share one unlocked
+// engine between all threads. Nonces need not be reproducible, so every
+// thread seeds its engine from std::random_device.
+namespace random {
+
+uint32_t generateWord32() { return static_cast<uint32_t>(GetEngine()()); }
+
+uint64_t generateWord64() { return GetEngine()(); }
+
+}  // namespace random
+
+bool IsRandomThreadLocal() {
+  uint64_t before = calls;
+  Interest interest(Name("/"));
+  interest.getNonce();
+  return calls != before;
+}
+
+}  // namespace ndn
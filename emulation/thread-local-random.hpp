@@ -0,0 +1,44 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef THREAD_LOCAL_RANDOM_HPP_
+#define THREAD_LOCAL_RANDOM_HPP_
+
+namespace ndn {
+
+/**
+ * Checks that ndn-cxx draws Interest nonces from the per-thread engines
+ * defined in thread-local-random.cpp.
+ *
+ * ndn-cxx 0.3 and 0.4 implement random::generateWord32() and
+ * random::generateWord64() on one static engine without a lock, and
+ * Face::expressInterest() calls them through Interest::getNonce(). Nodes
+ * running on different threads would race on that engine, so the emulation
+ * replaces both functions with per-thread ones. The replacement only takes
+ * effect if the ndn-cxx calls resolve to the executable's definitions, i.e.
+ * for a shared libndn-cxx that is not linked with -Bsymbolic; this function
+ * expresses that as a runtime check.
+ */
+bool IsRandomThreadLocal();
+
+}  // namespace ndn
+
+#endif  // THREAD_LOCAL_RANDOM_HPP_
@@ -26,6 +26,7 @@
 
 #include "ns3/double.h"
 #include "ns3/ndnSIM-module.h"
+#include "ns3/nstime.h"
 #include "ns3/string.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/traced-callback.h"
@@ -39,6 +40,7 @@ namespace ndn {
 class ChronoSyncApp : public Application {
  public:
   typedef void (*DataEventTraceCallback)(std::string, bool);
+  typedef void (*FetchEventTraceCallback)(bool, double, uint32_t);
 
   static TypeId GetTypeId() {
     static TypeId tid =
@@ -64,11 +66,58 @@ class ChronoSyncApp : public Application {
                 DoubleValue(1.0),
                 MakeDoubleAccessor(&ChronoSyncApp::data_rate_),
                 MakeDoubleChecker<double>())
+            .AddAttribute("RetryPolicy",
+                          "Data fetch retry policy: fixed, backoff, "
+                          "backoff-jitter or rtt.",
+                          StringValue("fixed"),
+                          MakeStringAccessor(&ChronoSyncApp::retry_policy_),
+                          MakeStringChecker())
+            .AddAttribute(
+                "MaxRetries",
+                "Maximum number of retransmissions of a data fetch Interest.",
+                UintegerValue(5),
+                MakeUintegerAccessor(&ChronoSyncApp::max_retries_),
+                MakeUintegerChecker<uint32_t>())
+            .AddAttribute(
+                "InterestLifetime",
+                "Lifetime of data fetch Interests, unless RetryPolicy is rtt.",
+                TimeValue(MilliSeconds(4000)),
+                MakeTimeAccessor(&ChronoSyncApp::interest_lifetime_),
+                MakeTimeChecker())
+            .AddAttribute(
+                "InitialBackoff",
+                "Delay before the first retransmission of a data fetch.",
+                TimeValue(MilliSeconds(50)),
+                MakeTimeAccessor(&ChronoSyncApp::initial_backoff_),
+                MakeTimeChecker())
+            .AddAttribute("MaxBackoff",
+                          "Upper bound on the retransmission delay.",
+                          TimeValue(Seconds(2.0)),
+                          MakeTimeAccessor(&ChronoSyncApp::max_backoff_),
+                          MakeTimeChecker())
+            .AddAttribute(
+                "BackoffMultiplier",
+                "Growth factor of the retransmission delay per attempt.",
+                DoubleValue(2.0),
+                MakeDoubleAccessor(&ChronoSyncApp::backoff_multiplier_),
+                MakeDoubleChecker<double>(1.0))
+            .AddAttribute("Jitter",
+                          "Relative randomization (+/-) of the retransmission "
+                          "delay for backoff-jitter and rtt policies.",
+                          DoubleValue(0.5),
+                          MakeDoubleAccessor(&ChronoSyncApp::jitter_),
+                          MakeDoubleChecker<double>(0.0, 1.0))
             .AddTraceSource(
                 "DataEvent",
                 "Event of publishing or receiving new data in the sync node.",
                 MakeTraceSourceAccessor(&ChronoSyncApp::data_event_trace_),
-                "ns3::ndn::vsync::SimpleNodeApp::DataEventTraceCallback");
+                "ns3::ndn::vsync::SimpleNodeApp::DataEventTraceCallback")
+            .AddTraceSource(
+                "FetchEvent",
+                "Completion of a data fetch: delivered or not, delay since "
+                "the first Interest in seconds, number of retransmissions.",
+                MakeTraceSourceAccessor(&ChronoSyncApp::fetch_event_trace_),
+                "ns3::ndn::ChronoSyncApp::FetchEventTraceCallback");
 
     return tid;
   }
@@ -76,12 +125,27 @@ class ChronoSyncApp : public Application {
  protected:
   // inherited from Application base class.
   virtual void StartApplication() {
+    ::ndn::FetchRetryPolicy policy;
+    if (!::ndn::FetchRetryPolicy::ParseKind(retry_policy_, &policy.kind))
+      NS_FATAL_ERROR("Unknown RetryPolicy: " << retry_policy_);
+    policy.max_retries = max_retries_;
+    policy.interest_lifetime =
+        ::ndn::time::milliseconds(interest_lifetime_.GetMilliSeconds());
+    policy.initial_backoff =
+        ::ndn::time::milliseconds(initial_backoff_.GetMilliSeconds());
+    policy.max_backoff =
+        ::ndn::time::milliseconds(max_backoff_.GetMilliSeconds());
+    policy.backoff_multiplier = backoff_multiplier_;
+    policy.jitter = jitter_;
+
     instance_.reset(new ::ndn::ChronoSyncNode(
         seed_, sync_prefix_, user_prefix_, routing_prefix_,
-        ndn::StackHelper::getKeyChain(), data_rate_));
+        ndn::StackHelper::getKeyChain(), data_rate_, policy));
     instance_->Init();
     instance_->ConnectDataEventTrace(
         std::bind(&ChronoSyncApp::TraceDataEvent, this, _1, _2));
+    instance_->ConnectFetchEventTrace(
+        std::bind(&ChronoSyncApp::TraceFetchEvent, this, _1, _2, _3));
     instance_->Run();
   }
 
@@ -91,6 +155,11 @@ class ChronoSyncApp : public Application {
     data_event_trace_(content, is_local);
   }
 
+  void TraceFetchEvent(bool delivered, ::ndn::time::nanoseconds delay,
+                       uint32_t retries) {
+    fetch_event_trace_(delivered, delay.count() / 1e9, retries);
+  }
+
  private:
   std::unique_ptr<::ndn::ChronoSyncNode> instance_;
   Name sync_prefix_;
@@ -99,7 +168,16 @@ class ChronoSyncApp : public Application {
   uint32_t seed_;
   double data_rate_;
 
+  std::string retry_policy_;
+  uint32_t max_retries_;
+  Time interest_lifetime_;
+  Time initial_backoff_;
+  Time max_backoff_;
+  double backoff_multiplier_;
+  double jitter_;
+
   TracedCallback<const std::string&, bool> data_event_trace_;
+  TracedCallback<bool, double, uint32_t> fetch_event_trace_;
 };
 
 }  // namespace ndn
@@ -23,12 +23,34 @@
 
 #include "chronosync-node.hpp"
 
+#include <algorithm>
+#include <functional>
+#include <string>
+
 namespace ndn {
 
+namespace {
+
+// Separates the retry jitter stream from the publish interval stream, which
+// rengine_ draws from the plain seed.
+const uint32_t kRetryStream = 0x72657472;  // "retr"
+
+// Nodes of a Synchronized run share one seed, so the user prefix is mixed
+// in to keep their retransmissions from jittering in lockstep.
+std::mt19937 MakeRetryEngine(uint32_t seed, const Name& user_prefix) {
+  uint64_t prefix = std::hash<std::string>()(user_prefix.toUri());
+  std::seed_seq seq{seed, kRetryStream, static_cast<uint32_t>(prefix),
+                    static_cast<uint32_t>(prefix >> 32)};
+  return std::mt19937(seq);
+}
+
+}  // namespace
+
 ChronoSyncNode::ChronoSyncNode(uint32_t seed, const Name& sync_prefix,
                                const Name& user_prefix,
                                const Name& routing_prefix, KeyChain& keychain,
-                               double data_rate)
+                               double data_rate,
+                               const FetchRetryPolicy& retry_policy)
     : face_(io_service_),
       scheduler_(io_service_),
       key_chain_(keychain),
@@ -37,23 +59,71 @@ ChronoSyncNode::ChronoSyncNode(uint32_t seed, const Name& sync_prefix,
       routing_prefix_(routing_prefix),
       seed_(seed),
       rengine_(seed),
-      rdist_(data_rate) {}
+      rdist_(data_rate),
+      retry_policy_(retry_policy),
+      retry_rengine_(MakeRetryEngine(seed, user_prefix)),
+      timers_(scheduler_) {
+  InitTimers();
+}
+
+ChronoSyncNode::ChronoSyncNode(uint32_t seed, const Name& sync_prefix,
+                               const Name& user_prefix,
+                               const Name& routing_prefix, KeyChain& keychain,
+                               double data_rate,
+                               const FetchRetryPolicy& retry_policy,
+                               shared_ptr<Transport> transport)
+    : face_(transport, io_service_, keychain),
+      scheduler_(io_service_),
+      key_chain_(keychain),
+      sync_prefix_(sync_prefix),
+      user_prefix_(user_prefix),
+      routing_prefix_(routing_prefix),
+      seed_(seed),
+      rengine_(seed),
+      rdist_(data_rate),
+      retry_policy_(retry_policy),
+      retry_rengine_(MakeRetryEngine(seed, user_prefix)),
+      timers_(scheduler_) {
+  InitTimers();
+}
+
+void ChronoSyncNode::InitTimers() {
+  publish_timer_.SetCallback([this] { PublishData(); });
+}
+
+ChronoSyncNode::PendingFetch* ChronoSyncNode::AcquireFetch() {
+  if (free_fetches_.empty()) {
+    fetch_pool_.emplace_back(new PendingFetch());
+    PendingFetch* fetch = fetch_pool_.back().get();
+    fetch->retry_timer.SetCallback(
+        [this, fetch] { ExpressFetchInterest(fetch); });
+    return fetch;
+  }
+  PendingFetch* fetch = free_fetches_.back();
+  free_fetches_.pop_back();
+  return fetch;
+}
+
+void ChronoSyncNode::ReleaseFetch(PendingFetch* fetch) {
+  timers_.Cancel(fetch->retry_timer);
+  free_fetches_.push_back(fetch);
+}
 
 void ChronoSyncNode::PublishData() {
-  if (counter_ >= 100) return;
+  if (counter_ >= max_messages_) return;
   std::string msg = user_prefix_.toUri() + ":" + std::to_string(++counter_);
   socket_->publishData(reinterpret_cast<const uint8_t*>(msg.data()), msg.size(),
                        ndn::time::milliseconds(3600000));
   data_event_trace_(msg, true);
 
-  scheduler_.scheduleEvent(
-      ndn::time::milliseconds(static_cast<int>(1000.0 * rdist_(rengine_))),
-      std::bind(&ChronoSyncNode::PublishData, this));
+  timers_.Schedule(
+      publish_timer_,
+      ndn::time::milliseconds(static_cast<int>(1000.0 * rdist_(rengine_))));
 }
 
-void ChronoSyncNode::ProcessData(const shared_ptr<const Data>& data) {
-  std::string msg(reinterpret_cast<const char*>(data->getContent().value()),
-                  data->getContent().value_size());
+void ChronoSyncNode::ProcessData(const Data& data) {
+  std::string msg(reinterpret_cast<const char*>(data.getContent().value()),
+                  data.getContent().value_size());
   data_event_trace_(msg, false);
 }
 
@@ -64,14 +134,77 @@ void ChronoSyncNode::ProcessSyncUpdate(
   }
 
   for (size_t i = 0; i < updates.size(); ++i) {
-    for (chronosync::SeqNo seq = updates[i].low; seq <= updates[i].high;
-         ++seq) {
-      socket_->fetchData(updates[i].session, seq,
-                         std::bind(&ChronoSyncNode::ProcessData, this, _1), 5);
+    SessionId session = sessions_.Intern(updates[i].session);
+    // Skip sequence numbers already being fetched or fetched before.
+    chronosync::SeqNo low =
+        std::max(updates[i].low, requested_.Get(session) + 1);
+    if (!requested_.Update(session, updates[i].high)) continue;
+    for (chronosync::SeqNo seq = low; seq <= updates[i].high; ++seq) {
+      FetchData(session, seq);
     }
   }
 }
 
+// Data fetching bypasses chronosync::Socket::fetchData(), which retransmits
+// immediately with the default Interest lifetime, so that retransmissions
+// follow retry_policy_. The Interest is the same one the socket would send.
+void ChronoSyncNode::FetchData(SessionId session, chronosync::SeqNo seq) {
+  PendingFetch* fetch = AcquireFetch();
+  fetch->session = session;
+  fetch->seq = seq;
+  fetch->retries = 0;
+  fetch->first_sent = time::steady_clock::now();
+  ExpressFetchInterest(fetch);
+}
+
+void ChronoSyncNode::ExpressFetchInterest(PendingFetch* fetch) {
+  Name interest_name;
+  interest_name.append(sessions_.GetName(fetch->session))
+      .appendNumber(fetch->seq);
+
+  Interest interest(interest_name);
+  interest.setMustBeFresh(true);
+  interest.setInterestLifetime(
+      retry_policy_.GetInterestLifetime(rtt_[fetch->session]));
+
+  fetch->last_sent = time::steady_clock::now();
+  face_.expressInterest(
+      interest, std::bind(&ChronoSyncNode::OnFetchData, this, _1, _2, fetch),
+      std::bind(&ChronoSyncNode::OnFetchTimeout, this, _1, fetch));
+}
+
+void ChronoSyncNode::OnFetchData(const Interest& interest, const Data& data,
+                                 PendingFetch* fetch) {
+  auto now = time::steady_clock::now();
+  // Karn's algorithm: only unambiguous samples feed the estimator.
+  if (fetch->retries == 0)
+    rtt_[fetch->session].AddMeasurement(now - fetch->last_sent);
+
+  fetch_event_trace_(true, now - fetch->first_sent, fetch->retries);
+  ReleaseFetch(fetch);
+  ProcessData(data);
+}
+
+void ChronoSyncNode::OnFetchTimeout(const Interest& interest,
+                                    PendingFetch* fetch) {
+  if (retry_policy_.UsesRttEstimator()) rtt_[fetch->session].BackoffRto();
+
+  if (fetch->retries >= retry_policy_.max_retries) {
+    fetch_event_trace_(false, time::steady_clock::now() - fetch->first_sent,
+                       fetch->retries);
+    ReleaseFetch(fetch);
+    return;
+  }
+
+  ++fetch->retries;
+  time::milliseconds delay =
+      retry_policy_.GetBackoff(fetch->retries, retry_rengine_);
+  if (delay == time::milliseconds::zero())
+    ExpressFetchInterest(fetch);
+  else
+    timers_.Schedule(fetch->retry_timer, delay);
+}
+
 void ChronoSyncNode::Init() {
   Name routable_user_prefix;
   routable_user_prefix.append(routing_prefix_).append(user_prefix_);
@@ -82,9 +215,9 @@ void ChronoSyncNode::Init() {
 }
 
 void ChronoSyncNode::Run() {
-  scheduler_.scheduleEvent(
-      ndn::time::milliseconds(static_cast<int>(1000.0 * rdist_(rengine_))),
-      std::bind(&ChronoSyncNode::PublishData, this));
+  timers_.Schedule(
+      publish_timer_,
+      ndn::time::milliseconds(static_cast<int>(1000.0 * rdist_(rengine_))));
 }
 
 }  // namespace ndn
@@ -25,11 +25,18 @@
 #define CHRONOSYNC_NODE_HPP_
 
 #include <functional>
+#include <memory>
 #include <random>
+#include <vector>
 
 #include "src/socket.hpp"
 
+#include "fetch-retry-policy.hpp"
+#include "scheduler-timer-wheel.hpp"
+#include "session-table.hpp"
+
 #include <ndn-cxx/face.hpp>
+#include <ndn-cxx/transport/transport.hpp>
 #include <ndn-cxx/util/signal.hpp>
 
 namespace ndn {
@@ -37,14 +44,25 @@ namespace ndn {
 class ChronoSyncNode {
  public:
   using DataEventTraceCb = std::function<void(const std::string&, bool)>;
+  using FetchEventTraceCb =
+      std::function<void(bool, time::nanoseconds, uint32_t)>;
 
   ChronoSyncNode(uint32_t seed, const Name& sync_prefix,
                  const Name& user_prefix, const Name& routing_prefix,
-                 KeyChain& keychain, double data_rate);
+                 KeyChain& keychain, double data_rate,
+                 const FetchRetryPolicy& retry_policy = FetchRetryPolicy());
+
+  // Connects the node's face to @p transport instead of the default one, so
+  // that the node can run outside ndnSIM (see emulation/).
+  ChronoSyncNode(uint32_t seed, const Name& sync_prefix,
+                 const Name& user_prefix, const Name& routing_prefix,
+                 KeyChain& keychain, double data_rate,
+                 const FetchRetryPolicy& retry_policy,
+                 shared_ptr<Transport> transport);
 
   void PublishData();
 
-  void ProcessData(const shared_ptr<const Data>& data);
+  void ProcessData(const Data& data);
 
   void ProcessSyncUpdate(
       const std::vector<chronosync::MissingDataInfo>& updates);
@@ -57,7 +75,42 @@ class ChronoSyncNode {
     data_event_trace_.connect(cb);
   }
 
+  void ConnectFetchEventTrace(FetchEventTraceCb cb) {
+    fetch_event_trace_.connect(cb);
+  }
+
+  // Number of messages published before the node stops publishing.
+  void SetMaxMessages(uint64_t max_messages) { max_messages_ = max_messages; }
+
+  boost::asio::io_service& GetIoService() { return io_service_; }
+
  private:
+  // Pooled by the node and reused across fetches. At any time a fetch has
+  // either one Interest outstanding or its retry timer pending.
+  struct PendingFetch {
+    SessionId session;
+    chronosync::SeqNo seq;
+    uint32_t retries;
+    time::steady_clock::TimePoint first_sent;
+    time::steady_clock::TimePoint last_sent;
+    TimerEntry retry_timer;
+  };
+
+  void InitTimers();
+
+  PendingFetch* AcquireFetch();
+
+  void ReleaseFetch(PendingFetch* fetch);
+
+  void FetchData(SessionId session, chronosync::SeqNo seq);
+
+  void ExpressFetchInterest(PendingFetch* fetch);
+
+  void OnFetchData(const Interest& interest, const Data& data,
+                   PendingFetch* fetch);
+
+  void OnFetchTimeout(const Interest& interest, PendingFetch* fetch);
+
   boost::asio::io_service io_service_;
   Face face_;
   Scheduler scheduler_;
@@ -73,8 +126,30 @@ class ChronoSyncNode {
   std::mt19937 rengine_;
   std::exponential_distribution<> rdist_;
 
+  // Sessions are interned as they appear in sync updates; per-session state
+  // below is indexed by SessionId.
+  SessionTable sessions_;
+  SessionSeqTable requested_;
+
+  FetchRetryPolicy retry_policy_;
+  SessionState<RttEstimator> rtt_;
+  std::mt19937 retry_rengine_;
+
+  // The publish timer and the backoff between fetch retries run on timers_.
+  // Retries without backoff (the fixed policy) are sent from the timeout
+  // callback directly. Declared before every TimerEntry so that it outlives
+  // them.
+  SchedulerTimerWheel timers_;
+
+  TimerEntry publish_timer_;
+  std::vector<std::unique_ptr<PendingFetch>> fetch_pool_;
+  std::vector<PendingFetch*> free_fetches_;
+
   uint64_t counter_ = 0;
+  uint64_t max_messages_ = 100;
   util::Signal<ChronoSyncNode, const std::string&, bool> data_event_trace_;
+  util::Signal<ChronoSyncNode, bool, time::nanoseconds, uint32_t>
+      fetch_event_trace_;
 };
 
 }  // namespace ndn
@@ -0,0 +1,212 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "delivery-tracker.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+#include "percentile.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+double Mean(const std::vector<double>& values) {
+  if (values.empty()) return 0.0;
+  return std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+}
+
+}  // namespace
+
+void DeliveryTracker::AddMember(const std::string& name, double start,
+                                double stop) {
+  size_t id = members_.size();
+  members_.push_back(Member{name, start, stop});
+  member_ids_[name] = id;
+  departures_.insert(std::make_pair(stop, id));
+}
+
+void DeliveryTracker::Publish(const std::string& member,
+                              const std::string& content, double now) {
+  AdvanceTo(now);
+
+  auto it = member_ids_.find(member);
+  if (it == member_ids_.end() || message_ids_.count(content) != 0) return;
+  size_t publisher = it->second;
+
+  size_t id = messages_.size();
+  message_ids_[content] = id;
+  messages_.push_back(Message());
+  Message& msg = messages_.back();
+  msg.content = content;
+  msg.publish_time = now;
+  msg.last_delivery = now;
+  msg.outstanding = 0;
+  msg.pending.assign(members_.size(), false);
+
+  for (size_t m = 0; m < members_.size(); ++m) {
+    if (m == publisher || members_[m].start > now || members_[m].stop <= now)
+      continue;
+    msg.pending[m] = true;
+    ++msg.outstanding;
+  }
+
+  if (msg.outstanding == 0) {
+    convergence_.push_back(0.0);
+    std::vector<bool>().swap(msg.pending);
+    return;
+  }
+
+  if (outstanding_ == 0) diverged_since_ = now;
+  outstanding_ += msg.outstanding;
+  expected_ += msg.outstanding;
+  incomplete_.insert(id);
+}
+
+void DeliveryTracker::Deliver(const std::string& member,
+                              const std::string& content, double now) {
+  AdvanceTo(now);
+
+  auto member_it = member_ids_.find(member);
+  auto message_it = message_ids_.find(content);
+  if (member_it == member_ids_.end() || message_it == message_ids_.end())
+    return;
+
+  const Message& msg = messages_[message_it->second];
+  if (msg.outstanding == 0 || !msg.pending[member_it->second]) {
+    ++duplicates_;
+    return;
+  }
+  Resolve(message_it->second, member_it->second, now, true);
+}
+
+void DeliveryTracker::NotifyLossBurstEnd(double now) {
+  AdvanceTo(now);
+  if (outstanding_ == 0)
+    burst_recovery_.push_back(0.0);
+  else
+    burst_ends_.push_back(now);
+}
+
+void DeliveryTracker::Finish(double now) { AdvanceTo(now); }
+
+double DeliveryTracker::GetDeliveryRatio() const {
+  if (expected_ == excused_) return 1.0;
+  return static_cast<double>(completed_) / (expected_ - excused_);
+}
+
+double DeliveryTracker::GetConvergencePercentile(double p) const {
+  return ::ndn::Percentile(convergence_.begin(), convergence_.end(), p);
+}
+
+void DeliveryTracker::AdvanceTo(double now) {
+  while (!departures_.empty() && departures_.begin()->first < now) {
+    double stop = departures_.begin()->first;
+    size_t member = departures_.begin()->second;
+    departures_.erase(departures_.begin());
+
+    // Copy, since Resolve() erases completed messages from incomplete_.
+    std::vector<size_t> candidates(incomplete_.begin(), incomplete_.end());
+    for (size_t id : candidates) {
+      if (messages_[id].pending[member]) Resolve(id, member, stop, false);
+    }
+  }
+}
+
+void DeliveryTracker::Resolve(size_t message_id, size_t member_id, double now,
+                              bool delivered) {
+  Message& msg = messages_[message_id];
+  msg.pending[member_id] = false;
+  --msg.outstanding;
+  --outstanding_;
+  if (delivered) {
+    ++completed_;
+    msg.last_delivery = now;
+  } else {
+    ++excused_;
+  }
+
+  if (msg.outstanding == 0) {
+    convergence_.push_back(msg.last_delivery - msg.publish_time);
+    std::vector<bool>().swap(msg.pending);
+    incomplete_.erase(message_id);
+  }
+
+  if (outstanding_ == 0) {
+    episodes_.push_back(now - diverged_since_);
+    for (double burst_end : burst_ends_)
+      burst_recovery_.push_back(now - burst_end);
+    burst_ends_.clear();
+  }
+}
+
+void DeliveryTracker::Report(std::ostream& os, size_t max_missing) const {
+  os << "Expected deliveries: " << expected_ - excused_ << " (" << excused_
+     << " excused by leaving nodes)" << std::endl;
+  os << "Completed deliveries: " << completed_ << " (" << duplicates_
+     << " duplicates ignored)" << std::endl;
+  os << "Missing deliveries: " << outstanding_ << " in " << incomplete_.size()
+     << " of " << messages_.size() << " messages" << std::endl;
+  os << "Delivery ratio is: " << GetDeliveryRatio() << std::endl;
+
+  double max_convergence =
+      convergence_.empty()
+          ? 0.0
+          : *std::max_element(convergence_.begin(), convergence_.end());
+  os << "Per-publish convergence time mean/p50/p99/max is: "
+     << Mean(convergence_) << "/" << GetConvergencePercentile(0.5) << "/"
+     << GetConvergencePercentile(0.99) << "/" << max_convergence
+     << " seconds." << std::endl;
+
+  double max_episode =
+      episodes_.empty() ? 0.0
+                        : *std::max_element(episodes_.begin(), episodes_.end());
+  os << "Group convergence episodes: " << episodes_.size()
+     << ", mean/max duration " << Mean(episodes_) << "/" << max_episode
+     << " seconds." << std::endl;
+
+  if (!burst_recovery_.empty() || !burst_ends_.empty()) {
+    os << "Convergence after loss bursts:";
+    for (double t : burst_recovery_) os << " " << t;
+    for (size_t i = 0; i < burst_ends_.size(); ++i) os << " never";
+    os << " seconds." << std::endl;
+  }
+
+  // Sort by message id so that the report is deterministic.
+  std::vector<size_t> missing(incomplete_.begin(), incomplete_.end());
+  std::sort(missing.begin(), missing.end());
+  if (missing.size() > max_missing) missing.resize(max_missing);
+  for (size_t id : missing) {
+    const Message& msg = messages_[id];
+    os << "  missing {" << msg.content << "} at";
+    for (size_t m = 0; m < msg.pending.size(); ++m)
+      if (msg.pending[m]) os << " " << members_[m].name;
+    os << std::endl;
+  }
+  if (incomplete_.size() > max_missing)
+    os << "  ... and " << incomplete_.size() - max_missing
+       << " more incomplete messages" << std::endl;
+}
+
+}  // namespace ndn
+}  // namespace ns3
@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DELIVERY_TRACKER_HPP_
+#define DELIVERY_TRACKER_HPP_
+
+#include <cstddef>
+#include <map>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * Streaming delivery-completeness and convergence metrics for a sync group.
+ *
+ * Feed it the DataEvent trace of every ChronoSyncApp in time order. Each
+ * published message expects delivery at every other member that is running
+ * at publish time. A member that stops before receiving a message is excused
+ * for it. All bookkeeping is done as events arrive; Finish() only walks the
+ * messages that are still incomplete.
+ *
+ * Convergence is reported in two ways:
+ *  - per publish: time from publishing a message until the last expected
+ *    member received it;
+ *  - per group episode: time from the group leaving a converged state (no
+ *    outstanding delivery) until it returns to one. NotifyLossBurstEnd()
+ *    additionally records how long the group needed to converge after a loss
+ *    burst ended.
+ */
+class DeliveryTracker {
+ public:
+  // Registers a member identified by the trace context used for its
+  // DataEvent trace, running during [start, stop) in seconds.
+  void AddMember(const std::string& name, double start, double stop);
+
+  void Publish(const std::string& member, const std::string& content,
+               double now);
+
+  void Deliver(const std::string& member, const std::string& content,
+               double now);
+
+  void NotifyLossBurstEnd(double now);
+
+  void Finish(double now);
+
+  size_t GetExpectedDeliveries() const { return expected_; }
+
+  size_t GetCompletedDeliveries() const { return completed_; }
+
+  size_t GetMissingDeliveries() const { return outstanding_; }
+
+  double GetDeliveryRatio() const;
+
+  // Per-publish convergence time percentile, @p p in [0, 1].
+  double GetConvergencePercentile(double p) const;
+
+  // Writes a summary plus up to @p max_missing incomplete messages.
+  void Report(std::ostream& os, size_t max_missing = 20) const;
+
+ private:
+  struct Member {
+    std::string name;
+    double start;
+    double stop;
+  };
+
+  struct Message {
+    std::string content;
+    double publish_time;
+    double last_delivery;
+    size_t outstanding;
+    std::vector<bool> pending;  // indexed by member id
+  };
+
+  void AdvanceTo(double now);
+
+  void Resolve(size_t message_id, size_t member_id, double now,
+               bool delivered);
+
+  std::vector<Member> members_;
+  std::unordered_map<std::string, size_t> member_ids_;
+  // Members ordered by stop time, consumed as simulated time advances.
+  std::multimap<double, size_t> departures_;
+
+  std::vector<Message> messages_;
+  std::unordered_map<std::string, size_t> message_ids_;
+  std::unordered_set<size_t> incomplete_;
+
+  size_t expected_ = 0;
+  size_t completed_ = 0;
+  size_t excused_ = 0;
+  size_t duplicates_ = 0;
+  size_t outstanding_ = 0;
+
+  mutable std::vector<double> convergence_;
+  std::vector<double> episodes_;
+  std::vector<double> burst_recovery_;
+  double diverged_since_ = 0.0;
+  std::vector<double> burst_ends_;
+};
+
+}  // namespace ndn
+}  // namespace ns3
+
+#endif  // DELIVERY_TRACKER_HPP_
@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "fetch-retry-policy.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "percentile.hpp"
+
+namespace ndn {
+
+RttEstimator::RttEstimator(time::milliseconds initial_rto,
+                           time::milliseconds min_rto,
+                           time::milliseconds max_rto)
+    : rto_(initial_rto.count()),
+      min_rto_(min_rto.count()),
+      max_rto_(max_rto.count()) {}
+
+void RttEstimator::AddMeasurement(time::nanoseconds rtt) {
+  double sample = rtt.count() / 1000000.0;
+  if (!has_sample_) {
+    srtt_ = sample;
+    rttvar_ = sample / 2.0;
+    has_sample_ = true;
+  } else {
+    rttvar_ = 0.75 * rttvar_ + 0.25 * std::abs(srtt_ - sample);
+    srtt_ = 0.875 * srtt_ + 0.125 * sample;
+  }
+  rto_ = std::min(max_rto_, std::max(min_rto_, srtt_ + 4.0 * rttvar_));
+}
+
+void RttEstimator::BackoffRto() { rto_ = std::min(max_rto_, rto_ * 2.0); }
+
+time::milliseconds RttEstimator::GetRto() const {
+  return time::milliseconds(static_cast<int64_t>(rto_));
+}
+
+bool FetchRetryPolicy::ParseKind(const std::string& name, Kind* kind) {
+  if (name == "fixed")
+    *kind = FIXED;
+  else if (name == "backoff")
+    *kind = BACKOFF;
+  else if (name == "backoff-jitter")
+    *kind = BACKOFF_JITTER;
+  else if (name == "rtt")
+    *kind = RTT;
+  else
+    return false;
+  return true;
+}
+
+std::string FetchRetryPolicy::KindToString(Kind kind) {
+  switch (kind) {
+    case FIXED:
+      return "fixed";
+    case BACKOFF:
+      return "backoff";
+    case BACKOFF_JITTER:
+      return "backoff-jitter";
+    case RTT:
+      return "rtt";
+  }
+  return "unknown";
+}
+
+time::milliseconds FetchRetryPolicy::GetInterestLifetime(
+    const RttEstimator& rtt) const {
+  if (kind == RTT) return rtt.GetRto();
+  return interest_lifetime;
+}
+
+time::milliseconds FetchRetryPolicy::GetBackoff(uint32_t attempt,
+                                                std::mt19937& rengine) const {
+  if (kind == FIXED || attempt == 0) return time::milliseconds(0);
+
+  double delay = initial_backoff.count() *
+                 std::pow(backoff_multiplier, static_cast<double>(attempt - 1));
+  delay = std::min(delay, static_cast<double>(max_backoff.count()));
+
+  if (kind != BACKOFF && jitter > 0.0) {
+    std::uniform_real_distribution<> rdist(1.0 - jitter, 1.0 + jitter);
+    delay *= rdist(rengine);
+  }
+  return time::milliseconds(static_cast<int64_t>(std::max(0.0, delay)));
+}
+
+void FetchStats::Record(bool delivered, double delay, uint32_t retries) {
+  retransmissions_ += retries;
+  if (delivered) {
+    ++delivered_;
+    delays_.push_back(delay);
+  } else {
+    ++failed_;
+  }
+}
+
+double FetchStats::GetDeliveryRatio() const {
+  if (GetAttempted() == 0) return 1.0;
+  return static_cast<double>(delivered_) / GetAttempted();
+}
+
+double FetchStats::GetDelayPercentile(double p) const {
+  return Percentile(delays_.begin(), delays_.end(), p);
+}
+
+}  // namespace ndn
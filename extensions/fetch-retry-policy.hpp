@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FETCH_RETRY_POLICY_HPP_
+#define FETCH_RETRY_POLICY_HPP_
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <ndn-cxx/util/time.hpp>
+
+namespace ndn {
+
+/**
+ * Smoothed RTT estimator following RFC 6298. ChronoSyncNode keeps one
+ * estimator per remote session, since every session is served by a different
+ * producer over a different path.
+ */
+class RttEstimator {
+ public:
+  explicit RttEstimator(
+      time::milliseconds initial_rto = time::milliseconds(1000),
+      time::milliseconds min_rto = time::milliseconds(50),
+      time::milliseconds max_rto = time::milliseconds(8000));
+
+  void AddMeasurement(time::nanoseconds rtt);
+
+  // Doubles the RTO after a timeout (Karn's algorithm).
+  void BackoffRto();
+
+  time::milliseconds GetRto() const;
+
+  bool HasSample() const { return has_sample_; }
+
+ private:
+  double srtt_ = 0.0;    // in milliseconds
+  double rttvar_ = 0.0;  // in milliseconds
+  double rto_;           // in milliseconds
+  double min_rto_;
+  double max_rto_;
+  bool has_sample_ = false;
+};
+
+/**
+ * Decides Interest lifetime and retransmission delay for data fetches.
+ *
+ *   fixed           fixed lifetime, immediate retransmission (the behavior of
+ *                   chronosync::Socket::fetchData)
+ *   backoff         fixed lifetime, exponential backoff between attempts
+ *   backoff-jitter  as "backoff", with the delay randomized by +/- Jitter
+ *   rtt             lifetime taken from the per-session RTT estimator, with
+ *                   jittered exponential backoff
+ */
+class FetchRetryPolicy {
+ public:
+  enum Kind { FIXED, BACKOFF, BACKOFF_JITTER, RTT };
+
+  FetchRetryPolicy() = default;
+
+  // Returns false if @p name does not denote a known policy.
+  static bool ParseKind(const std::string& name, Kind* kind);
+
+  static std::string KindToString(Kind kind);
+
+  time::milliseconds GetInterestLifetime(const RttEstimator& rtt) const;
+
+  // Delay before retransmission number @p attempt (starting from 1).
+  time::milliseconds GetBackoff(uint32_t attempt, std::mt19937& rengine) const;
+
+  bool UsesRttEstimator() const { return kind == RTT; }
+
+  Kind kind = FIXED;
+  uint32_t max_retries = 5;
+  time::milliseconds interest_lifetime = time::milliseconds(4000);
+  time::milliseconds initial_backoff = time::milliseconds(50);
+  time::milliseconds max_backoff = time::milliseconds(2000);
+  double backoff_multiplier = 2.0;
+  double jitter = 0.5;
+};
+
+/**
+ * Aggregates fetch outcomes reported through the FetchEvent trace source, so
+ * that scenarios can compare policies by delivery ratio and tail delay.
+ */
+class FetchStats {
+ public:
+  void Record(bool delivered, double delay, uint32_t retries);
+
+  size_t GetAttempted() const { return delivered_ + failed_; }
+
+  size_t GetDelivered() const { return delivered_; }
+
+  size_t GetRetransmissions() const { return retransmissions_; }
+
+  double GetDeliveryRatio() const;
+
+  // Fetch delay percentile over delivered fetches, @p p in [0, 1].
+  double GetDelayPercentile(double p) const;
+
+ private:
+  size_t delivered_ = 0;
+  size_t failed_ = 0;
+  size_t retransmissions_ = 0;
+  mutable std::vector<double> delays_;
+};
+
+}  // namespace ndn
+
+#endif  // FETCH_RETRY_POLICY_HPP_
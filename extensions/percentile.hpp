@@ -0,0 +1,48 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PERCENTILE_HPP_
+#define PERCENTILE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+
+namespace ndn {
+
+// Index of the nearest-rank @p p percentile, 0 <= p <= 1, among @p count > 0
+// sorted values.
+inline size_t PercentileRank(size_t count, double p) {
+  return std::min(count - 1, static_cast<size_t>(p * (count - 1) + 0.5));
+}
+
+// Nearest-rank @p p percentile of [@p begin, @p end), or 0 if the range is
+// empty. Partially reorders the range.
+template <typename Iterator>
+double Percentile(Iterator begin, Iterator end, double p) {
+  if (begin == end) return 0.0;
+  Iterator kth = begin + PercentileRank(end - begin, p);
+  std::nth_element(begin, kth, end);
+  return *kth;
+}
+
+}  // namespace ndn
+
+#endif  // PERCENTILE_HPP_
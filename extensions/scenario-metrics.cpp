@@ -0,0 +1,77 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "scenario-metrics.hpp"
+
+#include <numeric>
+
+#include "ns3/node-list.h"
+
+#include "percentile.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+void ScenarioMetrics::InstallAll(const Name& sync_prefix) {
+  sync_prefix_ = sync_prefix;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End();
+       ++node) {
+    Ptr<L3Protocol> l3 = (*node)->GetObject<L3Protocol>();
+    if (l3 == nullptr) continue;
+    l3->TraceConnectWithoutContext(
+        "OutInterests", MakeCallback(&ScenarioMetrics::OutInterests, this));
+    l3->TraceConnectWithoutContext(
+        "OutData", MakeCallback(&ScenarioMetrics::OutData, this));
+  }
+}
+
+void ScenarioMetrics::Print(std::ostream& os,
+                            const DeliveryTracker& tracker) {
+  double mean =
+      delays_.empty()
+          ? 0.0
+          : std::accumulate(delays_.begin(), delays_.end(), 0.0) /
+                delays_.size();
+  size_t deliveries = tracker.GetCompletedDeliveries();
+  double packets_per_delivery =
+      deliveries == 0 ? 0.0
+                      : static_cast<double>(interests_ + data_) / deliveries;
+  double sync_interests_per_publish =
+      publishes_ == 0 ? 0.0
+                      : static_cast<double>(sync_interests_) / publishes_;
+
+  os << "METRIC delivery_ratio " << tracker.GetDeliveryRatio() << std::endl;
+  os << "METRIC delay_mean " << mean << std::endl;
+  os << "METRIC delay_p50 "
+     << ::ndn::Percentile(delays_.begin(), delays_.end(), 0.5) << std::endl;
+  os << "METRIC delay_p99 "
+     << ::ndn::Percentile(delays_.begin(), delays_.end(), 0.99) << std::endl;
+  os << "METRIC convergence_p99 " << tracker.GetConvergencePercentile(0.99)
+     << std::endl;
+  os << "METRIC interests " << interests_ << std::endl;
+  os << "METRIC data " << data_ << std::endl;
+  os << "METRIC packets_per_delivery " << packets_per_delivery << std::endl;
+  os << "METRIC sync_interests_per_publish " << sync_interests_per_publish
+     << std::endl;
+}
+
+}  // namespace ndn
+}  // namespace ns3
@@ -0,0 +1,80 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCENARIO_METRICS_HPP_
+#define SCENARIO_METRICS_HPP_
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "ns3/ndnSIM-module.h"
+
+#include "delivery-tracker.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * Machine-readable summary of a scenario run for benchmarks/regression.py.
+ * Print() writes one "METRIC <name> <value>" line per metric:
+ *
+ *   delivery_ratio        from the DeliveryTracker
+ *   delay_mean/p50/p99    per-delivery propagation delay in seconds
+ *   convergence_p99       per-publish convergence time in seconds
+ *   interests, data       packets sent by all forwarders
+ *   packets_per_delivery  (interests + data) / completed deliveries
+ *   sync_interests_per_publish
+ *                         sync Interests sent by all forwarders per published
+ *                         message, i.e. per state change
+ */
+class ScenarioMetrics {
+ public:
+  // Connects to the L3Protocol packet traces of every node. Interests under
+  // @p sync_prefix are also counted as sync Interests.
+  void InstallAll(const Name& sync_prefix);
+
+  void RecordPublish() { ++publishes_; }
+
+  void RecordDelivery(double delay) { delays_.push_back(delay); }
+
+  void Print(std::ostream& os, const DeliveryTracker& tracker);
+
+ private:
+  void OutInterests(const Interest& interest, const Face& face) {
+    ++interests_;
+    if (sync_prefix_.isPrefixOf(interest.getName())) ++sync_interests_;
+  }
+
+  void OutData(const Data& data, const Face& face) { ++data_; }
+
+  Name sync_prefix_;
+  uint64_t interests_ = 0;
+  uint64_t sync_interests_ = 0;
+  uint64_t data_ = 0;
+  uint64_t publishes_ = 0;
+  std::vector<double> delays_;
+};
+
+}  // namespace ndn
+}  // namespace ns3
+
+#endif  // SCENARIO_METRICS_HPP_
@@ -0,0 +1,72 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "scheduler-timer-wheel.hpp"
+
+namespace ndn {
+
+SchedulerTimerWheel::SchedulerTimerWheel(Scheduler& scheduler)
+    : scheduler_(scheduler), epoch_(time::steady_clock::now()) {
+  // Capturing only |this| keeps the callback within std::function's small
+  // buffer, so copying it into the scheduler does not allocate.
+  callback_ = [this] { OnEvent(); };
+}
+
+SchedulerTimerWheel::~SchedulerTimerWheel() {
+  if (armed_ != TimerWheel::kNever) scheduler_.cancelEvent(event_);
+}
+
+void SchedulerTimerWheel::Schedule(TimerEntry& entry,
+                                   time::milliseconds delay) {
+  wheel_.Schedule(entry, GetTick() + delay.count());
+  Arm();
+}
+
+void SchedulerTimerWheel::Arm() {
+  if (advancing_) return;
+
+  // A wakeup at or before the next expiry is already pending; it re-arms
+  // when it fires.
+  uint64_t next = wheel_.GetNextExpiry();
+  if (next >= armed_) return;
+
+  if (armed_ != TimerWheel::kNever) scheduler_.cancelEvent(event_);
+  armed_ = next;
+  uint64_t now = GetTick();
+  event_ = scheduler_.scheduleEvent(
+      time::milliseconds(next > now ? next - now : 0), callback_);
+}
+
+void SchedulerTimerWheel::OnEvent() {
+  armed_ = TimerWheel::kNever;
+  ++wakeups_;
+  advancing_ = true;
+  wheel_.Advance(GetTick());
+  advancing_ = false;
+  Arm();
+}
+
+uint64_t SchedulerTimerWheel::GetTick() const {
+  return time::duration_cast<time::milliseconds>(time::steady_clock::now() -
+                                                 epoch_).count();
+}
+
+}  // namespace ndn
@@ -0,0 +1,80 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCHEDULER_TIMER_WHEEL_HPP_
+#define SCHEDULER_TIMER_WHEEL_HPP_
+
+#include <cstdint>
+#include <functional>
+
+#include <ndn-cxx/util/scheduler.hpp>
+
+#include "timer-wheel.hpp"
+
+namespace ndn {
+
+/**
+ * TimerWheel on 1 ms ticks of time::steady_clock, driven by an
+ * ndn::Scheduler.
+ *
+ * At most one scheduler event is pending. It is armed for the earliest
+ * expiry on the wheel and is only moved when a timer is scheduled before it;
+ * cancelling or pushing back timers leaves it alone, and a wakeup that finds
+ * nothing due just re-arms. The scheduler therefore allocates once per
+ * wakeup, however many timers fire or are re-armed in it.
+ */
+class SchedulerTimerWheel {
+ public:
+  explicit SchedulerTimerWheel(Scheduler& scheduler);
+
+  ~SchedulerTimerWheel();
+
+  SchedulerTimerWheel(const SchedulerTimerWheel&) = delete;
+  SchedulerTimerWheel& operator=(const SchedulerTimerWheel&) = delete;
+
+  // (Re)schedules @p entry to fire after @p delay, at 1 ms granularity.
+  void Schedule(TimerEntry& entry, time::milliseconds delay);
+
+  void Cancel(TimerEntry& entry) { wheel_.Cancel(entry); }
+
+  // Number of scheduler events that have fired so far.
+  uint64_t GetWakeups() const { return wakeups_; }
+
+ private:
+  void Arm();
+
+  void OnEvent();
+
+  uint64_t GetTick() const;
+
+  Scheduler& scheduler_;
+  TimerWheel wheel_;
+  time::steady_clock::TimePoint epoch_;
+  EventId event_;
+  uint64_t armed_ = TimerWheel::kNever;
+  bool advancing_ = false;
+  std::function<void()> callback_;
+  uint64_t wakeups_ = 0;
+};
+
+}  // namespace ndn
+
+#endif  // SCHEDULER_TIMER_WHEEL_HPP_
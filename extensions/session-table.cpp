@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "session-table.hpp"
+
+namespace ndn {
+
+const SessionId SessionTable::kInvalid;
+const uint64_t SessionSeqTable::kNone;
+
+// FNV-1a over the type and value of every component.
+size_t SessionTable::NameHash::operator()(const Name& name) const {
+  uint64_t hash = 14695981039346656037ULL;
+  for (const name::Component& component : name) {
+    hash = (hash ^ component.type()) * 1099511628211ULL;
+    const uint8_t* value = component.value();
+    for (size_t i = 0; i < component.value_size(); ++i)
+      hash = (hash ^ value[i]) * 1099511628211ULL;
+  }
+  return static_cast<size_t>(hash);
+}
+
+SessionId SessionTable::Intern(const Name& session) {
+  auto it = ids_.find(session);
+  if (it != ids_.end()) return it->second;
+
+  SessionId id = static_cast<SessionId>(names_.size());
+  it = ids_.insert(std::make_pair(session, id)).first;
+  names_.push_back(&it->first);
+  return id;
+}
+
+SessionId SessionTable::Find(const Name& session) const {
+  auto it = ids_.find(session);
+  return it == ids_.end() ? kInvalid : it->second;
+}
+
+bool SessionSeqTable::Update(SessionId id, uint64_t seq,
+                             SessionSeqRange* covered) {
+  if (id >= seqs_.size()) seqs_.resize(id + 1, kNone);
+  if (seq <= seqs_[id]) return false;
+
+  if (covered != nullptr) *covered = SessionSeqRange{id, seqs_[id] + 1, seq};
+  seqs_[id] = seq;
+  return true;
+}
+
+void SessionSeqTable::Merge(const SessionSeqTable& other,
+                            std::vector<SessionSeqRange>* updates) {
+  if (other.seqs_.size() > seqs_.size())
+    seqs_.resize(other.seqs_.size(), kNone);
+
+  for (SessionId id = 0; id < other.seqs_.size(); ++id) {
+    if (other.seqs_[id] <= seqs_[id]) continue;
+    updates->push_back(SessionSeqRange{id, seqs_[id] + 1, other.seqs_[id]});
+    seqs_[id] = other.seqs_[id];
+  }
+}
+
+void SessionSeqTable::Diff(const SessionSeqTable& other,
+                           std::vector<SessionSeqRange>* missing) const {
+  for (SessionId id = 0; id < seqs_.size(); ++id) {
+    uint64_t theirs = other.Get(id);
+    if (seqs_[id] > theirs)
+      missing->push_back(SessionSeqRange{id, theirs + 1, seqs_[id]});
+  }
+}
+
+}  // namespace ndn
@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SESSION_TABLE_HPP_
+#define SESSION_TABLE_HPP_
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include <ndn-cxx/name.hpp>
+
+namespace ndn {
+
+using SessionId = uint32_t;
+
+/**
+ * Interns session names into dense ids, so that per-session state can be kept
+ * in arrays indexed by id rather than in containers keyed by Name. A name is
+ * hashed and compared once, when it enters the node; everything downstream
+ * works on ids. Ids are never reused.
+ */
+class SessionTable {
+ public:
+  static const SessionId kInvalid = std::numeric_limits<SessionId>::max();
+
+  // Returns the id of @p session, assigning the next free id if it is new.
+  SessionId Intern(const Name& session);
+
+  // Returns the id of @p session, or kInvalid if it was never interned.
+  SessionId Find(const Name& session) const;
+
+  const Name& GetName(SessionId id) const { return *names_[id]; }
+
+  size_t GetSize() const { return names_.size(); }
+
+ private:
+  struct NameHash {
+    size_t operator()(const Name& name) const;
+  };
+
+  std::unordered_map<Name, SessionId, NameHash> ids_;
+  // Points into the keys of ids_, whose nodes never move.
+  std::vector<const Name*> names_;
+};
+
+/**
+ * Per-session state indexed by SessionId, grown on demand. Entries of ids
+ * not yet touched are value-initialized.
+ */
+template <typename T>
+class SessionState {
+ public:
+  T& operator[](SessionId id) {
+    if (id >= values_.size()) values_.resize(id + 1);
+    return values_[id];
+  }
+
+  size_t GetSize() const { return values_.size(); }
+
+ private:
+  std::vector<T> values_;
+};
+
+struct SessionSeqRange {
+  SessionId session;
+  uint64_t low;
+  uint64_t high;
+};
+
+/**
+ * Highest known sequence number of every session, stored as one flat array.
+ * Merge() and Diff() walk two tables side by side, which is what reconciling
+ * two sync states amounts to.
+ */
+class SessionSeqTable {
+ public:
+  static const uint64_t kNone = 0;
+
+  // Sequence numbers start at 1; kNone means nothing is known yet.
+  uint64_t Get(SessionId id) const {
+    return id < seqs_.size() ? seqs_[id] : kNone;
+  }
+
+  // Raises the sequence number of @p id to @p seq and stores the newly
+  // covered range in @p covered. Returns false if @p seq is not newer.
+  bool Update(SessionId id, uint64_t seq, SessionSeqRange* covered = nullptr);
+
+  // Takes every sequence number in @p other that is newer than ours, and
+  // appends the newly covered ranges to @p updates.
+  void Merge(const SessionSeqTable& other,
+             std::vector<SessionSeqRange>* updates);
+
+  // Appends the ranges we know that @p other does not.
+  void Diff(const SessionSeqTable& other,
+            std::vector<SessionSeqRange>* missing) const;
+
+  size_t GetSize() const { return seqs_.size(); }
+
+ private:
+  std::vector<uint64_t> seqs_;
+};
+
+}  // namespace ndn
+
+#endif  // SESSION_TABLE_HPP_
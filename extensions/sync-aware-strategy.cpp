@@ -0,0 +1,68 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "sync-aware-strategy.hpp"
+
+namespace nfd {
+namespace fw {
+
+const Name SyncAwareStrategy::STRATEGY_NAME(
+    "ndn:/localhost/nfd/strategy/sync-aware/%FD%01");
+
+const double SyncAwareStrategy::kHoldDownFraction = 0.5;
+
+SyncAwareStrategy::SyncAwareStrategy(Forwarder& forwarder, const Name& name)
+    : Strategy(forwarder, name) {}
+
+void SyncAwareStrategy::afterReceiveInterest(const Face& inFace,
+                                             const Interest& interest,
+                                             shared_ptr<fib::Entry> fibEntry,
+                                             shared_ptr<pit::Entry> pitEntry) {
+  time::milliseconds lifetime = interest.getInterestLifetime();
+  if (lifetime < time::milliseconds::zero())
+    lifetime = ndn::DEFAULT_INTEREST_LIFETIME;
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  time::steady_clock::TimePoint hold_down_start =
+      now -
+      time::duration_cast<time::nanoseconds>(lifetime * kHoldDownFraction);
+
+  bool held_down = false;
+  const fib::NextHopList& nexthops = fibEntry->getNextHops();
+  for (fib::NextHopList::const_iterator it = nexthops.begin();
+       it != nexthops.end(); ++it) {
+    shared_ptr<Face> outFace = it->getFace();
+    if (!pitEntry->canForwardTo(*outFace)) continue;
+
+    auto last = last_forwarded_.find(outFace->getId());
+    if (last != last_forwarded_.end() && last->second > hold_down_start) {
+      held_down = true;
+      continue;
+    }
+    last_forwarded_[outFace->getId()] = now;
+    this->sendInterest(pitEntry, outFace);
+  }
+
+  if (!held_down && !pitEntry->hasUnexpiredOutRecords())
+    this->rejectPendingInterest(pitEntry);
+}
+
+}  // namespace fw
+}  // namespace nfd
@@ -0,0 +1,72 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SYNC_AWARE_STRATEGY_HPP_
+#define SYNC_AWARE_STRATEGY_HPP_
+
+#include <unordered_map>
+
+#include "face/face.hpp"
+#include "fw/strategy.hpp"
+
+namespace nfd {
+namespace fw {
+
+/**
+ * Multicast strategy for the sync prefix that keeps at most one recently
+ * forwarded sync Interest per upstream face, across state digests.
+ *
+ * The multicast strategy already merges the copies of one digest, which
+ * share a PIT entry: canForwardTo() skips faces with a live out-record. But
+ * every new digest is a new PIT entry, so a burst of publishes that passes
+ * through k intermediate digests sends k sync Interests to every upstream.
+ * This strategy forwards to an upstream only if it has not forwarded any
+ * sync Interest to that face within kHoldDownFraction of the incoming
+ * Interest's lifetime. A held-down face gets the then current digest with
+ * the next copy after the hold-down; ChronoSync re-expresses its sync
+ * Interest every half lifetime, so that copy arrives soon. The price is that
+ * an upstream may learn of a new digest up to one hold-down later.
+ *
+ * An entry whose upstreams were all held down stays pending rather than
+ * being rejected, so that a later copy can still forward it.
+ */
+class SyncAwareStrategy : public Strategy {
+ public:
+  static const Name STRATEGY_NAME;
+
+  static const double kHoldDownFraction;
+
+  SyncAwareStrategy(Forwarder& forwarder, const Name& name = STRATEGY_NAME);
+
+  virtual void afterReceiveInterest(const Face& inFace,
+                                    const Interest& interest,
+                                    shared_ptr<fib::Entry> fibEntry,
+                                    shared_ptr<pit::Entry> pitEntry);
+
+ private:
+  // When a sync Interest was last forwarded to each upstream face.
+  std::unordered_map<FaceId, time::steady_clock::TimePoint> last_forwarded_;
+};
+
+}  // namespace fw
+}  // namespace nfd
+
+#endif  // SYNC_AWARE_STRATEGY_HPP_
@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "timer-wheel.hpp"
+
+#include <algorithm>
+
+namespace ndn {
+
+const int TimerWheel::kLevelBits;
+const uint64_t TimerWheel::kSlots;
+const int TimerWheel::kLevels;
+const uint64_t TimerWheel::kNever;
+
+namespace {
+
+inline uint64_t LevelSpan(int level) {
+  return uint64_t(1) << (TimerWheel::kLevelBits * level);
+}
+
+}  // namespace
+
+TimerEntry::~TimerEntry() {
+  if (wheel_ != nullptr) wheel_->Cancel(*this);
+}
+
+TimerWheel::TimerWheel() {
+  std::fill(&slots_[0][0], &slots_[0][0] + kLevels * kSlots, nullptr);
+  std::fill(occupied_, occupied_ + kLevels, 0);
+}
+
+TimerWheel::~TimerWheel() {
+  for (int level = 0; level < kLevels; ++level) {
+    for (uint64_t slot = 0; slot < kSlots; ++slot) {
+      while (slots_[level][slot] != nullptr) Unlink(*slots_[level][slot]);
+    }
+  }
+}
+
+void TimerWheel::Schedule(TimerEntry& entry, uint64_t expiry) {
+  if (entry.wheel_ != nullptr) entry.wheel_->Cancel(entry);
+  entry.expiry_ = std::max(expiry, now_ + 1);
+  entry.wheel_ = this;
+  Link(entry);
+}
+
+void TimerWheel::Cancel(TimerEntry& entry) {
+  if (entry.wheel_ != this) return;
+  Unlink(entry);
+}
+
+void TimerWheel::Advance(uint64_t now) {
+  while (now_ < now) {
+    uint64_t next = GetNextExpiry();
+    if (next > now) {
+      now_ = now;
+      break;
+    }
+    now_ = next;
+
+    for (int level = 1; level < kLevels; ++level) {
+      if ((now_ & (LevelSpan(level) - 1)) != 0) break;
+      Cascade(level, (now_ >> (kLevelBits * level)) & (kSlots - 1));
+    }
+
+    // Level 0 slot of the current tick only holds timers due now. Entries are
+    // taken one at a time, since callbacks may cancel other due entries.
+    TimerEntry*& head = slots_[0][now_ & (kSlots - 1)];
+    while (head != nullptr) {
+      TimerEntry& entry = *head;
+      Unlink(entry);
+      if (entry.callback_) entry.callback_();
+    }
+  }
+}
+
+uint64_t TimerWheel::GetNextExpiry() const {
+  if (size_ == 0) return kNever;
+
+  uint64_t next = kNever;
+  for (int level = 0; level < kLevels; ++level) {
+    uint64_t bits = occupied_[level];
+    int shift = kLevelBits * level;
+    uint64_t rotation = (now_ >> shift) & ~(kSlots - 1);
+    while (bits != 0) {
+      uint64_t slot = __builtin_ctzll(bits);
+      bits &= bits - 1;
+      // First tick after now_ at which this slot is expired or cascaded.
+      uint64_t tick = (rotation | slot) << shift;
+      if (tick <= now_) tick += LevelSpan(level + 1);
+      next = std::min(next, tick);
+    }
+  }
+  return next;
+}
+
+void TimerWheel::Link(TimerEntry& entry) {
+  uint64_t delta = entry.expiry_ - now_;
+  int level = 0;
+  while (level < kLevels - 1 && delta >= LevelSpan(level + 1)) ++level;
+  if (delta >= LevelSpan(kLevels)) entry.expiry_ = now_ + LevelSpan(kLevels) - 1;
+
+  uint64_t slot = (entry.expiry_ >> (kLevelBits * level)) & (kSlots - 1);
+  entry.level_ = level;
+  entry.slot_ = slot;
+  entry.prev_ = nullptr;
+  entry.next_ = slots_[level][slot];
+  if (entry.next_ != nullptr) entry.next_->prev_ = &entry;
+  slots_[level][slot] = &entry;
+  occupied_[level] |= uint64_t(1) << slot;
+  ++size_;
+}
+
+void TimerWheel::Unlink(TimerEntry& entry) {
+  if (entry.prev_ != nullptr)
+    entry.prev_->next_ = entry.next_;
+  else
+    slots_[entry.level_][entry.slot_] = entry.next_;
+  if (entry.next_ != nullptr) entry.next_->prev_ = entry.prev_;
+  if (slots_[entry.level_][entry.slot_] == nullptr)
+    occupied_[entry.level_] &= ~(uint64_t(1) << entry.slot_);
+
+  entry.prev_ = entry.next_ = nullptr;
+  entry.wheel_ = nullptr;
+  --size_;
+}
+
+void TimerWheel::Cascade(int level, uint64_t slot) {
+  while (slots_[level][slot] != nullptr) {
+    TimerEntry& entry = *slots_[level][slot];
+    Unlink(entry);
+    entry.wheel_ = this;
+    Link(entry);
+  }
+}
+
+}  // namespace ndn
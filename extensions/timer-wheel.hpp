@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TIMER_WHEEL_HPP_
+#define TIMER_WHEEL_HPP_
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+
+namespace ndn {
+
+class TimerWheel;
+
+/**
+ * Intrusive timer owned by the caller. The callback is set once and the
+ * entry can be rescheduled any number of times without allocating.
+ */
+class TimerEntry {
+ public:
+  TimerEntry() = default;
+
+  explicit TimerEntry(std::function<void()> callback)
+      : callback_(std::move(callback)) {}
+
+  // Cancels the timer if it is still pending.
+  ~TimerEntry();
+
+  TimerEntry(const TimerEntry&) = delete;
+  TimerEntry& operator=(const TimerEntry&) = delete;
+
+  void SetCallback(std::function<void()> callback) {
+    callback_ = std::move(callback);
+  }
+
+  bool IsPending() const { return wheel_ != nullptr; }
+
+ private:
+  friend class TimerWheel;
+
+  std::function<void()> callback_;
+  TimerWheel* wheel_ = nullptr;
+  TimerEntry* prev_ = nullptr;
+  TimerEntry* next_ = nullptr;
+  uint64_t expiry_ = 0;
+  int level_ = 0;
+  uint64_t slot_ = 0;
+};
+
+/**
+ * Hierarchical timer wheel with kLevels levels of kSlots slots, counting
+ * abstract ticks. Timers further out than the wheel span are clamped to it.
+ *
+ * The wheel does not own a clock: the caller advances it to the current
+ * tick and asks for the next tick at which anything is due, so that a
+ * single underlying scheduler event can drive all timers of a node.
+ */
+class TimerWheel {
+ public:
+  static const int kLevelBits = 6;
+  static const uint64_t kSlots = 1 << kLevelBits;
+  static const int kLevels = 4;
+  static const uint64_t kNever = std::numeric_limits<uint64_t>::max();
+
+  TimerWheel();
+
+  ~TimerWheel();
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  // (Re)schedules @p entry to fire at absolute tick @p expiry. Expiries not
+  // after the current tick fire on the next Advance().
+  void Schedule(TimerEntry& entry, uint64_t expiry);
+
+  void Cancel(TimerEntry& entry);
+
+  // Fires, in tick order, every timer due at or before @p now. Callbacks may
+  // schedule and cancel entries, including their own.
+  void Advance(uint64_t now);
+
+  // Tick at which Advance() next has work to do, or kNever if empty.
+  uint64_t GetNextExpiry() const;
+
+  uint64_t GetNow() const { return now_; }
+
+  bool IsEmpty() const { return size_ == 0; }
+
+ private:
+  void Link(TimerEntry& entry);
+
+  void Unlink(TimerEntry& entry);
+
+  void Cascade(int level, uint64_t slot);
+
+  uint64_t now_ = 0;
+  uint64_t size_ = 0;
+  TimerEntry* slots_[kLevels][kSlots];
+  uint64_t occupied_[kLevels];
+};
+
+}  // namespace ndn
+
+#endif  // TIMER_WHEEL_HPP_
@@ -0,0 +1,250 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "traffic-class-tracer.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "ns3/channel.h"
+#include "ns3/data-rate.h"
+#include "ns3/names.h"
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+#include "ns3/ndnSIM/model/ndn-net-device-face.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+std::string GetNodeName(Ptr<Node> node) {
+  std::string name = Names::FindName(node);
+  return name.empty() ? std::to_string(node->GetId()) : name;
+}
+
+}  // namespace
+
+TrafficClassTracer::TrafficClassTracer(const std::string& file_name,
+                                       Time period, const Name& sync_prefix)
+    : os_(file_name.c_str(), std::ios_base::out | std::ios_base::trunc),
+      period_(period),
+      sync_prefix_(sync_prefix),
+      recovery_prefix_(Name(sync_prefix).append("recovery")) {
+  os_ << "Time\tNode\tFaceId\tFaceDescr\tClass\tDirection\tPackets\t"
+         "Kilobytes\tPacketRaw\tKilobytesRaw\n";
+}
+
+void TrafficClassTracer::InstallAll() {
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End();
+       ++node) {
+    Ptr<L3Protocol> l3 = (*node)->GetObject<L3Protocol>();
+    if (l3 == nullptr) continue;
+
+    nodes_.emplace_back(new NodeCounters());
+    NodeCounters* counters = nodes_.back().get();
+    counters->tracer = this;
+    counters->node = GetNodeName(*node);
+
+    l3->TraceConnectWithoutContext(
+        "InInterests",
+        MakeBoundCallback(&TrafficClassTracer::InInterests, counters));
+    l3->TraceConnectWithoutContext(
+        "OutInterests",
+        MakeBoundCallback(&TrafficClassTracer::OutInterests, counters));
+    l3->TraceConnectWithoutContext(
+        "InData", MakeBoundCallback(&TrafficClassTracer::InData, counters));
+    l3->TraceConnectWithoutContext(
+        "OutData", MakeBoundCallback(&TrafficClassTracer::OutData, counters));
+  }
+  start_ = Simulator::Now();
+  Simulator::Schedule(period_, &TrafficClassTracer::Dump, this);
+}
+
+const char* TrafficClassTracer::ClassToString(Class traffic_class) {
+  switch (traffic_class) {
+    case SYNC_INTEREST:
+      return "sync-interest";
+    case SYNC_REPLY:
+      return "sync-reply";
+    case RECOVERY:
+      return "recovery";
+    case DATA:
+      return "data";
+    default:
+      return "unknown";
+  }
+}
+
+void TrafficClassTracer::InInterests(NodeCounters* node,
+                                     const Interest& interest,
+                                     const Face& face) {
+  node->tracer->Count(*node, face, IN,
+                      node->tracer->ClassifyInterest(interest.getName()),
+                      interest.wireEncode().size());
+}
+
+void TrafficClassTracer::OutInterests(NodeCounters* node,
+                                      const Interest& interest,
+                                      const Face& face) {
+  node->tracer->Count(*node, face, OUT,
+                      node->tracer->ClassifyInterest(interest.getName()),
+                      interest.wireEncode().size());
+}
+
+void TrafficClassTracer::InData(NodeCounters* node, const Data& data,
+                                const Face& face) {
+  node->tracer->Count(*node, face, IN,
+                      node->tracer->ClassifyData(data.getName()),
+                      data.wireEncode().size());
+}
+
+void TrafficClassTracer::OutData(NodeCounters* node, const Data& data,
+                                 const Face& face) {
+  node->tracer->Count(*node, face, OUT,
+                      node->tracer->ClassifyData(data.getName()),
+                      data.wireEncode().size());
+}
+
+TrafficClassTracer::Class TrafficClassTracer::ClassifyInterest(
+    const Name& name) const {
+  if (!sync_prefix_.isPrefixOf(name)) return DATA;
+  return recovery_prefix_.isPrefixOf(name) ? RECOVERY : SYNC_INTEREST;
+}
+
+TrafficClassTracer::Class TrafficClassTracer::ClassifyData(
+    const Name& name) const {
+  if (!sync_prefix_.isPrefixOf(name)) return DATA;
+  return recovery_prefix_.isPrefixOf(name) ? RECOVERY : SYNC_REPLY;
+}
+
+void TrafficClassTracer::Count(NodeCounters& node, const Face& face,
+                               Direction direction, Class traffic_class,
+                               size_t bytes) {
+  FaceCounters& counters = GetFace(node, face);
+  Counter& window = counters.window[direction][traffic_class];
+  ++window.packets;
+  window.bytes += bytes;
+  Counter& total = counters.total[direction][traffic_class];
+  ++total.packets;
+  total.bytes += bytes;
+}
+
+// Nodes have few faces, so a linear scan beats any map here.
+TrafficClassTracer::FaceCounters& TrafficClassTracer::GetFace(
+    NodeCounters& node, const Face& face) {
+  for (FaceCounters& counters : node.faces)
+    if (counters.face_id == face.getId()) return counters;
+
+  node.faces.push_back(FaceCounters());
+  FaceCounters& counters = node.faces.back();
+  counters.face_id = face.getId();
+  counters.node = node.node;
+  counters.capacity = 0;
+
+  const NetDeviceFace* device_face = dynamic_cast<const NetDeviceFace*>(&face);
+  if (device_face != nullptr) {
+    Ptr<NetDevice> device = device_face->GetNetDevice();
+    Ptr<Channel> channel = device->GetChannel();
+    for (size_t i = 0; channel != nullptr && i < channel->GetNDevices(); ++i) {
+      Ptr<NetDevice> other = channel->GetDevice(i);
+      if (other != device) counters.peer = GetNodeName(other->GetNode());
+    }
+    DataRateValue rate;
+    if (device->GetAttributeFailSafe("DataRate", rate))
+      counters.capacity = rate.Get().GetBitRate();
+  }
+  return counters;
+}
+
+void TrafficClassTracer::Dump() {
+  double now = Simulator::Now().ToDouble(Time::S);
+  double seconds = period_.ToDouble(Time::S);
+  static const char* kDirectionNames[kDirections] = {"In", "Out"};
+
+  char buf[256];
+  for (const auto& node : nodes_) {
+    for (FaceCounters& face : node->faces) {
+      const char* descr = face.peer.empty() ? "local" : face.peer.c_str();
+      for (int d = 0; d < kDirections; ++d) {
+        for (int c = 0; c < kClasses; ++c) {
+          Counter& window = face.window[d][c];
+          if (window.packets == 0) continue;
+          int n = std::snprintf(
+              buf, sizeof(buf),
+              "%.6g\t%s\t%lld\t%s\t%s\t%s\t%.6g\t%.6g\t%llu\t%.6g\n", now,
+              node->node.c_str(), static_cast<long long>(face.face_id), descr,
+              ClassToString(static_cast<Class>(c)), kDirectionNames[d],
+              window.packets / seconds, window.bytes / 1024.0 / seconds,
+              static_cast<unsigned long long>(window.packets),
+              window.bytes / 1024.0);
+          os_.write(buf, std::min<size_t>(n, sizeof(buf) - 1));
+          window = Counter();
+        }
+      }
+    }
+  }
+  os_.flush();
+
+  Simulator::Schedule(period_, &TrafficClassTracer::Dump, this);
+}
+
+void TrafficClassTracer::Report(std::ostream& os, Time stop,
+                                size_t top) const {
+  double seconds = (stop - start_).ToDouble(Time::S);
+
+  std::vector<const FaceCounters*> links;
+  for (const auto& node : nodes_)
+    for (const FaceCounters& face : node->faces)
+      if (!face.peer.empty()) links.push_back(&face);
+
+  for (int c = 0; c < kClasses; ++c) {
+    uint64_t packets = 0, bytes = 0;
+    for (const FaceCounters* link : links) {
+      packets += link->total[OUT][c].packets;
+      bytes += link->total[OUT][c].bytes;
+    }
+    os << "Traffic class " << ClassToString(static_cast<Class>(c)) << ": "
+       << packets << " packets, " << bytes / 1024.0 << " KB sent on "
+       << links.size() << " links" << std::endl;
+    if (bytes == 0) continue;
+
+    std::vector<const FaceCounters*> sorted(links);
+    size_t n = std::min(top, sorted.size());
+    std::partial_sort(sorted.begin(), sorted.begin() + n, sorted.end(),
+                      [c](const FaceCounters* x, const FaceCounters* y) {
+                        return x->total[OUT][c].bytes > y->total[OUT][c].bytes;
+                      });
+    for (size_t i = 0; i < n && sorted[i]->total[OUT][c].bytes > 0; ++i) {
+      const FaceCounters& link = *sorted[i];
+      const Counter& total = link.total[OUT][c];
+      os << "  " << link.node << " -> " << link.peer << ": " << total.packets
+         << " packets, " << total.bytes / 1024.0 << " KB";
+      if (link.capacity > 0 && seconds > 0.0)
+        os << ", " << 100.0 * total.bytes * 8 / seconds / link.capacity
+           << "% of link capacity";
+      os << std::endl;
+    }
+  }
+}
+
+}  // namespace ndn
+}  // namespace ns3
@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRAFFIC_CLASS_TRACER_HPP_
+#define TRAFFIC_CLASS_TRACER_HPP_
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "ns3/ndnSIM-module.h"
+#include "ns3/nstime.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * Per-face packet and byte counts split by ChronoSync traffic class:
+ *
+ *   sync-interest  Interests under the sync prefix (including resets)
+ *   sync-reply     Data under the sync prefix
+ *   recovery       Interests and Data under <sync prefix>/recovery
+ *   data           everything else, i.e. application data fetches
+ *
+ * Counters are fixed arrays per face. Every period, the tracer writes one
+ * row per face, class and direction that saw traffic, in the layout of
+ * L3RateTracer (rates per second plus raw counts). Report() lists the most
+ * loaded links per class over the whole run, with their utilization when the
+ * device has a DataRate attribute.
+ */
+class TrafficClassTracer {
+ public:
+  enum Class { SYNC_INTEREST, SYNC_REPLY, RECOVERY, DATA, kClasses };
+
+  enum Direction { IN, OUT, kDirections };
+
+  TrafficClassTracer(const std::string& file_name, Time period,
+                     const Name& sync_prefix);
+
+  // Connects to the L3Protocol packet traces of every node and schedules
+  // the first dump.
+  void InstallAll();
+
+  // Writes the @p top most loaded links per class by bytes sent, with
+  // utilization averaged from InstallAll() until @p stop.
+  void Report(std::ostream& os, Time stop, size_t top = 10) const;
+
+  static const char* ClassToString(Class traffic_class);
+
+ private:
+  struct Counter {
+    uint64_t packets;
+    uint64_t bytes;
+  };
+
+  struct FaceCounters {
+    int64_t face_id;
+    std::string node;
+    std::string peer;  // empty unless the face is a point-to-point link
+    uint64_t capacity;  // link bit rate, 0 if unknown
+    Counter window[kDirections][kClasses];
+    Counter total[kDirections][kClasses];
+  };
+
+  struct NodeCounters {
+    TrafficClassTracer* tracer;
+    std::string node;
+    std::vector<FaceCounters> faces;
+  };
+
+  // L3Protocol trace callbacks, bound to the counters of their node.
+  static void InInterests(NodeCounters* node, const Interest& interest,
+                          const Face& face);
+
+  static void OutInterests(NodeCounters* node, const Interest& interest,
+                           const Face& face);
+
+  static void InData(NodeCounters* node, const Data& data, const Face& face);
+
+  static void OutData(NodeCounters* node, const Data& data, const Face& face);
+
+  void Count(NodeCounters& node, const Face& face, Direction direction,
+             Class traffic_class, size_t bytes);
+
+  Class ClassifyInterest(const Name& name) const;
+
+  Class ClassifyData(const Name& name) const;
+
+  FaceCounters& GetFace(NodeCounters& node, const Face& face);
+
+  void Dump();
+
+  std::ofstream os_;
+  Time period_;
+  Name sync_prefix_;
+  Name recovery_prefix_;
+  Time start_;
+
+  std::vector<std::unique_ptr<NodeCounters>> nodes_;
+};
+
+}  // namespace ndn
+}  // namespace ns3
+
+#endif  // TRAFFIC_CLASS_TRACER_HPP_
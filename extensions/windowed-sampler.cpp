@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "windowed-sampler.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+
+#include "percentile.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const size_t WindowedSampler::kMaxDelaySamples;
+
+WindowedSampler::WindowedSampler(const std::string& file_name, Time window,
+                                 const Name& sync_prefix)
+    : os_(file_name.c_str(), std::ios_base::out | std::ios_base::trunc),
+      window_(window),
+      sync_prefix_(sync_prefix) {
+  os_ << "Time\tPublishes\tDeliveries\tDelayP50\tDelayP90\tDelayP99\t"
+         "DelayMax\tSyncInterests\tSyncData\tFetchInterests\tFetchData\n";
+}
+
+void WindowedSampler::InstallAll() {
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End();
+       ++node) {
+    Ptr<L3Protocol> l3 = (*node)->GetObject<L3Protocol>();
+    if (l3 == nullptr) continue;
+    l3->TraceConnectWithoutContext(
+        "OutInterests", MakeCallback(&WindowedSampler::OutInterests, this));
+    l3->TraceConnectWithoutContext(
+        "OutData", MakeCallback(&WindowedSampler::OutData, this));
+  }
+  Simulator::Schedule(window_, &WindowedSampler::Flush, this);
+}
+
+void WindowedSampler::RecordDelivery(double delay) {
+  ++deliveries_;
+  delays_[delay_head_] = delay;
+  delay_head_ = (delay_head_ + 1) % kMaxDelaySamples;
+  if (delay_count_ < kMaxDelaySamples) ++delay_count_;
+}
+
+void WindowedSampler::OutInterests(const Interest& interest, const Face&) {
+  if (sync_prefix_.isPrefixOf(interest.getName()))
+    ++sync_interests_;
+  else
+    ++fetch_interests_;
+}
+
+void WindowedSampler::OutData(const Data& data, const Face&) {
+  if (sync_prefix_.isPrefixOf(data.getName()))
+    ++sync_data_;
+  else
+    ++fetch_data_;
+}
+
+void WindowedSampler::Flush() {
+  // The ring is reset every window, so valid samples always start at 0.
+  double p50 = 0.0, p90 = 0.0, p99 = 0.0, max = 0.0;
+  if (delay_count_ > 0) {
+    auto begin = delays_.begin();
+    auto end = begin + delay_count_;
+    std::sort(begin, end);
+    p50 = begin[::ndn::PercentileRank(delay_count_, 0.50)];
+    p90 = begin[::ndn::PercentileRank(delay_count_, 0.90)];
+    p99 = begin[::ndn::PercentileRank(delay_count_, 0.99)];
+    max = begin[delay_count_ - 1];
+  }
+
+  char buf[256];
+  int n = std::snprintf(
+      buf, sizeof(buf), "%.6g\t%llu\t%llu\t%.6g\t%.6g\t%.6g\t%.6g\t%llu\t%llu\t"
+                        "%llu\t%llu\n",
+      Simulator::Now().ToDouble(Time::S),
+      static_cast<unsigned long long>(publishes_),
+      static_cast<unsigned long long>(deliveries_), p50, p90, p99, max,
+      static_cast<unsigned long long>(sync_interests_),
+      static_cast<unsigned long long>(sync_data_),
+      static_cast<unsigned long long>(fetch_interests_),
+      static_cast<unsigned long long>(fetch_data_));
+  os_.write(buf, std::min<size_t>(n, sizeof(buf) - 1));
+  os_.flush();
+
+  publishes_ = deliveries_ = 0;
+  sync_interests_ = sync_data_ = fetch_interests_ = fetch_data_ = 0;
+  delay_head_ = delay_count_ = 0;
+
+  Simulator::Schedule(window_, &WindowedSampler::Flush, this);
+}
+
+}  // namespace ndn
+}  // namespace ns3
@@ -0,0 +1,90 @@
+/* -*- Mode:C++; c-file-style:"google"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors
+ * and contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WINDOWED_SAMPLER_HPP_
+#define WINDOWED_SAMPLER_HPP_
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "ns3/ndnSIM-module.h"
+#include "ns3/nstime.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * Samples publishes, deliveries, delivery delay percentiles and packet
+ * counts over fixed windows of simulated time.
+ *
+ * Windows end at multiples of the window length, which is where
+ * L3RateTracer prints when installed with the same averaging period, so the
+ * two files can be joined on the Time column (see graphs/timeseries.R).
+ *
+ * Delay samples go to a fixed-size ring buffer; if a window overflows it,
+ * percentiles are computed over the most recent kMaxDelaySamples deliveries
+ * while the delivery count stays exact. Each window is formatted into a
+ * stack buffer and written to the file with a single call.
+ */
+class WindowedSampler {
+ public:
+  static const size_t kMaxDelaySamples = 8192;
+
+  WindowedSampler(const std::string& file_name, Time window,
+                  const Name& sync_prefix);
+
+  // Connects to the L3Protocol packet traces of every node and schedules
+  // the first window.
+  void InstallAll();
+
+  void RecordPublish() { ++publishes_; }
+
+  void RecordDelivery(double delay);
+
+ private:
+  void OutInterests(const Interest& interest, const Face& face);
+
+  void OutData(const Data& data, const Face& face);
+
+  void Flush();
+
+  std::ofstream os_;
+  Time window_;
+  Name sync_prefix_;
+
+  uint64_t publishes_ = 0;
+  uint64_t deliveries_ = 0;
+  uint64_t sync_interests_ = 0;
+  uint64_t sync_data_ = 0;
+  uint64_t fetch_interests_ = 0;
+  uint64_t fetch_data_ = 0;
+
+  std::array<double, kMaxDelaySamples> delays_;
+  size_t delay_head_ = 0;
+  size_t delay_count_ = 0;
+};
+
+}  // namespace ndn
+}  // namespace ns3
+
+#endif  // WINDOWED_SAMPLER_HPP_
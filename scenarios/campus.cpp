@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <numeric>
 #include <string>
 #include <unordered_map>
@@ -14,11 +15,21 @@
 #include "ns3/point-to-point-module.h"
 #include "ns3/random-variable-stream.h"
 
+#include "delivery-tracker.hpp"
+#include "fetch-retry-policy.hpp"
+#include "scenario-metrics.hpp"
+#include "sync-aware-strategy.hpp"
+#include "windowed-sampler.hpp"
+
 NS_LOG_COMPONENT_DEFINE("ns3.ndn.chronosync.scenarios.Campus");
 
 namespace ns3 {
 
 std::unordered_map<std::string, std::pair<double, std::vector<double>>> delays;
+::ndn::FetchStats fetch_stats;
+ndn::DeliveryTracker delivery_tracker;
+ndn::ScenarioMetrics metrics;
+std::unique_ptr<ndn::WindowedSampler> sampler;
 
 static void DataEvent(std::string user_prefix, const std::string& content,
                       bool is_local) {
@@ -29,15 +40,31 @@ static void DataEvent(std::string user_prefix, const std::string& content,
   double now = Simulator::Now().GetSeconds();
 
   auto& entry = delays[content];
-  if (is_local)
+  if (is_local) {
     entry.first = now;
-  else
+    delivery_tracker.Publish(user_prefix, content, now);
+    metrics.RecordPublish();
+    if (sampler) sampler->RecordPublish();
+  } else {
     entry.second.push_back(now);
+    delivery_tracker.Deliver(user_prefix, content, now);
+    metrics.RecordDelivery(now - entry.first);
+    if (sampler) sampler->RecordDelivery(now - entry.first);
+  }
+}
+
+static void FetchEvent(std::string user_prefix, bool delivered, double delay,
+                       uint32_t retries) {
+  fetch_stats.Record(delivered, delay, retries);
 }
 
 int main(int argc, char* argv[]) {
   double TotalRunTimeSeconds = 60.0;
   double LossRate = 0.0;
+  std::string RetryPolicy = "fixed";
+  std::string SyncStrategy = "multicast";
+  uint32_t RandomSeed = 1;
+  double SamplingPeriod = 0.0;
   bool Synchronized = false;
   double DataRate = 1.0;
 
@@ -46,6 +73,18 @@ int main(int argc, char* argv[]) {
                "Total running time of the simulation in seconds",
                TotalRunTimeSeconds);
   cmd.AddValue("LossRate", "Packet loss rate in the network", LossRate);
+  cmd.AddValue("RetryPolicy",
+               "Data fetch retry policy (fixed, backoff, backoff-jitter, rtt)",
+               RetryPolicy);
+  cmd.AddValue("SyncStrategy",
+               "Forwarding strategy for sync Interests (multicast, sync-aware)",
+               SyncStrategy);
+  cmd.AddValue("RandomSeed", "Seed of the simulator's random number generator",
+               RandomSeed);
+  cmd.AddValue("SamplingPeriod",
+               "If > 0, sample rate and delay time series with this period "
+               "in seconds",
+               SamplingPeriod);
   cmd.AddValue(
       "Synchronized",
       "If set, the data publishing events from all nodes are synchronized",
@@ -54,6 +93,10 @@ int main(int argc, char* argv[]) {
                DataRate);
   cmd.Parse(argc, argv);
 
+  if (SyncStrategy != "multicast" && SyncStrategy != "sync-aware")
+    NS_FATAL_ERROR("Unknown sync strategy " << SyncStrategy);
+  RngSeedManager::SetSeed(RandomSeed);
+
   AnnotatedTopologyReader topologyReader("", 25);
   topologyReader.SetFileName("topologies/campus.txt");
   topologyReader.Read();
@@ -67,8 +110,12 @@ int main(int argc, char* argv[]) {
   ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
   ndnGlobalRoutingHelper.InstallAll();
 
-  ndn::StrategyChoiceHelper::InstallAll("/ndn/broadcast/sync",
-                                        "/localhost/nfd/strategy/multicast");
+  if (SyncStrategy == "sync-aware")
+    ndn::StrategyChoiceHelper::InstallAll<nfd::fw::SyncAwareStrategy>(
+        "/ndn/broadcast/sync");
+  else
+    ndn::StrategyChoiceHelper::InstallAll("/ndn/broadcast/sync",
+                                          "/localhost/nfd/strategy/multicast");
 
   Ptr<UniformRandomVariable> seed = CreateObject<UniformRandomVariable>();
   seed->SetAttribute("Min", DoubleValue(0.0));
@@ -87,18 +134,22 @@ int main(int argc, char* argv[]) {
     helper.SetAttribute("SyncPrefix", StringValue("/ndn/broadcast/sync"));
     std::string user_prefix = '/' + nid;
     helper.SetAttribute("UserPrefix", StringValue(user_prefix));
+    helper.SetAttribute("RetryPolicy", StringValue(RetryPolicy));
     helper.SetAttribute("StartTime", TimeValue(Seconds(1.0)));
     helper.SetAttribute("StopTime", TimeValue(Seconds(TotalRunTimeSeconds)));
     helper.SetAttribute("DataRate", DoubleValue(DataRate));
     if (!Synchronized)
       helper.SetAttribute("RandomSeed", UintegerValue(seed->GetInteger()));
     helper.Install(node);
+    delivery_tracker.AddMember(nid, 1.0, TotalRunTimeSeconds);
 
     ndnGlobalRoutingHelper.AddOrigins(user_prefix, node);
     ndnGlobalRoutingHelper.AddOrigins("/ndn/broadcast/sync", node);
 
     node->GetApplication(0)->TraceConnect("DataEvent", nid,
                                           MakeCallback(&DataEvent));
+    node->GetApplication(0)->TraceConnect("FetchEvent", nid,
+                                          MakeCallback(&FetchEvent));
     node->GetDevice(0)->SetAttribute("ReceiveErrorModel", PointerValue(rem));
   }
 
@@ -110,14 +161,30 @@ int main(int argc, char* argv[]) {
       "results/CS-CampusRunTime" + std::to_string(TotalRunTimeSeconds);
   if (Synchronized) file_name += "Sync";
   if (LossRate > 0.0) file_name += "LR" + std::to_string(LossRate);
+  if (RetryPolicy != "fixed") file_name += "RP" + RetryPolicy;
+  if (SyncStrategy != "multicast") file_name += "SS" + SyncStrategy;
+  if (RandomSeed != 1) file_name += "RS" + std::to_string(RandomSeed);
   if (DataRate != 1.0) file_name += "DR" + std::to_string(DataRate);
 
-  ndn::L3RateTracer::InstallAll(file_name + "-rate-trace.txt",
-                                Seconds(TotalRunTimeSeconds - 0.5));
+  if (SamplingPeriod > 0.0) {
+    ndn::L3RateTracer::InstallAll(file_name + "-rate-trace.txt",
+                                  Seconds(SamplingPeriod));
+    sampler.reset(new ndn::WindowedSampler(file_name + "-timeseries.txt",
+                                           Seconds(SamplingPeriod),
+                                           "/ndn/broadcast/sync"));
+    sampler->InstallAll();
+  } else {
+    ndn::L3RateTracer::InstallAll(file_name + "-rate-trace.txt",
+                                  Seconds(TotalRunTimeSeconds - 0.5));
+  }
+
+  metrics.InstallAll("/ndn/broadcast/sync");
 
   Simulator::Run();
   Simulator::Destroy();
 
+  delivery_tracker.Finish(TotalRunTimeSeconds);
+
   std::fstream fs(file_name, std::ios_base::out | std::ios_base::trunc);
 
   int count = 0;
@@ -142,6 +209,17 @@ int main(int argc, char* argv[]) {
   std::cout << "Total number of data propagated is: " << count << std::endl;
   std::cout << "Average data propagation delay is: " << average_delay
             << " seconds." << std::endl;
+  std::cout << "Fetch delivery ratio (" << RetryPolicy
+            << " retry policy) is: " << fetch_stats.GetDeliveryRatio() << " ("
+            << fetch_stats.GetDelivered() << "/" << fetch_stats.GetAttempted()
+            << ", " << fetch_stats.GetRetransmissions()
+            << " retransmissions)" << std::endl;
+  std::cout << "Fetch delay p50/p99 is: "
+            << fetch_stats.GetDelayPercentile(0.5) << "/"
+            << fetch_stats.GetDelayPercentile(0.99) << " seconds."
+            << std::endl;
+  delivery_tracker.Report(std::cout);
+  metrics.Print(std::cout, delivery_tracker);
 
   return 0;
 }
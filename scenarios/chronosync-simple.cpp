@@ -26,6 +26,10 @@
 #include "ns3/network-module.h"
 #include "ns3/point-to-point-module.h"
 
+#include <iostream>
+
+#include "traffic-class-tracer.hpp"
+
 namespace ns3 {
 namespace ndn {
 
@@ -109,9 +113,16 @@ int main(int argc, char* argv[]) {
 
   Simulator::Stop(Seconds(20.0));
 
+  // Per-second rates of sync, recovery and data traffic on every face
+  TrafficClassTracer traffic_tracer("traffic-classes.txt", Seconds(1.0),
+                                    "/ndn/broadcast/sync");
+  traffic_tracer.InstallAll();
+
   Simulator::Run();
   Simulator::Destroy();
 
+  traffic_tracer.Report(std::cout, Seconds(20.0));
+
   return 0;
 }
 
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <numeric>
 #include <string>
 #include <unordered_map>
@@ -14,11 +15,22 @@
 #include "ns3/point-to-point-module.h"
 #include "ns3/random-variable-stream.h"
 
+#include "delivery-tracker.hpp"
+#include "fetch-retry-policy.hpp"
+#include "scenario-metrics.hpp"
+#include "sync-aware-strategy.hpp"
+#include "traffic-class-tracer.hpp"
+#include "windowed-sampler.hpp"
+
 NS_LOG_COMPONENT_DEFINE("ns3.ndn.chronosync.scenarios.HubAndSpoke");
 
 namespace ns3 {
 
 std::unordered_map<std::string, std::pair<double, std::vector<double>>> delays;
+::ndn::FetchStats fetch_stats;
+ndn::DeliveryTracker delivery_tracker;
+ndn::ScenarioMetrics metrics;
+std::unique_ptr<ndn::WindowedSampler> sampler;
 
 static void DataEvent(std::string user_prefix, const std::string& content,
                       bool is_local) {
@@ -29,10 +41,31 @@ static void DataEvent(std::string user_prefix, const std::string& content,
   double now = Simulator::Now().GetSeconds();
 
   auto& entry = delays[content];
-  if (is_local)
+  if (is_local) {
     entry.first = now;
-  else
+    delivery_tracker.Publish(user_prefix, content, now);
+    metrics.RecordPublish();
+    if (sampler) sampler->RecordPublish();
+  } else {
     entry.second.push_back(now);
+    delivery_tracker.Deliver(user_prefix, content, now);
+    metrics.RecordDelivery(now - entry.first);
+    if (sampler) sampler->RecordDelivery(now - entry.first);
+  }
+}
+
+static void FetchEvent(std::string user_prefix, bool delivered, double delay,
+                       uint32_t retries) {
+  fetch_stats.Record(delivered, delay, retries);
+}
+
+static void SetLossRate(Ptr<RateErrorModel> rem, double rate) {
+  rem->SetAttribute("ErrorRate", DoubleValue(rate));
+}
+
+static void EndLossBurst(Ptr<RateErrorModel> rem, double rate) {
+  SetLossRate(rem, rate);
+  delivery_tracker.NotifyLossBurstEnd(Simulator::Now().GetSeconds());
 }
 
 int main(int argc, char* argv[]) {
@@ -46,8 +79,16 @@ int main(int argc, char* argv[]) {
   double TotalRunTimeSeconds = 100.0;
   bool Synchronized = false;
   double LossRate = 0.0;
+  std::string RetryPolicy = "fixed";
+  std::string SyncStrategy = "multicast";
+  uint32_t RandomSeed = 1;
+  double SamplingPeriod = 0.0;
   std::string LinkDelay = "10ms";
   int LeavingNodes = 0;
+  double LossBurstStart = 0.0;
+  double LossBurstDuration = 1.0;
+  double LossBurstRate = 0.5;
+  double DataRate = 1.0;
 
   CommandLine cmd;
   cmd.AddValue("NumOfNodes", "Number of sync nodes in the group", N);
@@ -59,12 +100,37 @@ int main(int argc, char* argv[]) {
       "If set, the data publishing events from all nodes are synchronized",
       Synchronized);
   cmd.AddValue("LossRate", "Packet loss rate in the network", LossRate);
+  cmd.AddValue("RetryPolicy",
+               "Data fetch retry policy (fixed, backoff, backoff-jitter, rtt)",
+               RetryPolicy);
+  cmd.AddValue("SyncStrategy",
+               "Forwarding strategy for sync Interests (multicast, sync-aware)",
+               SyncStrategy);
+  cmd.AddValue("RandomSeed", "Seed of the simulator's random number generator",
+               RandomSeed);
+  cmd.AddValue("SamplingPeriod",
+               "If > 0, sample rate and delay time series with this period "
+               "in seconds",
+               SamplingPeriod);
   cmd.AddValue("LinkDelay", "Delay of the underlying P2P channel", LinkDelay);
   cmd.AddValue("LeavingNodes",
                "Number of nodes randomly leaving the group after 20s",
                LeavingNodes);
+  cmd.AddValue("LossBurstStart",
+               "Start time in seconds of a loss burst on all links (0: none)",
+               LossBurstStart);
+  cmd.AddValue("LossBurstDuration", "Duration of the loss burst in seconds",
+               LossBurstDuration);
+  cmd.AddValue("LossBurstRate", "Packet loss rate during the loss burst",
+               LossBurstRate);
+  cmd.AddValue("DataRate", "Data publishing rate (packets per second)",
+               DataRate);
   cmd.Parse(argc, argv);
 
+  if (SyncStrategy != "multicast" && SyncStrategy != "sync-aware")
+    NS_FATAL_ERROR("Unknown sync strategy " << SyncStrategy);
+  RngSeedManager::SetSeed(RandomSeed);
+
   if (TotalRunTimeSeconds < 20.0) return -1;
 
   NodeContainer nodes;
@@ -89,6 +155,9 @@ int main(int argc, char* argv[]) {
 
   ndn::StrategyChoiceHelper::InstallAll("/ndn",
                                         "/localhost/nfd/strategy/multicast");
+  if (SyncStrategy == "sync-aware")
+    ndn::StrategyChoiceHelper::InstallAll<nfd::fw::SyncAwareStrategy>(
+        "/ndn/broadcast/sync");
 
   Ptr<UniformRandomVariable> seed = CreateObject<UniformRandomVariable>();
   seed->SetAttribute("Min", DoubleValue(0.0));
@@ -103,15 +172,16 @@ int main(int argc, char* argv[]) {
     helper.SetAttribute("SyncPrefix", StringValue("/ndn/broadcast/sync"));
     std::string user_prefix = "/Node" + std::to_string(i);
     helper.SetAttribute("UserPrefix", StringValue(user_prefix));
+    helper.SetAttribute("RetryPolicy", StringValue(RetryPolicy));
+    helper.SetAttribute("DataRate", DoubleValue(DataRate));
     if (!Synchronized)
       helper.SetAttribute("RandomSeed", UintegerValue(seed->GetInteger()));
     helper.SetAttribute("StartTime", TimeValue(Seconds(1.0)));
-    if (i <= LeavingNodes)
-      helper.SetAttribute("StopTime",
-                          TimeValue(Seconds(stop_time->GetValue())));
-    else
-      helper.SetAttribute("StopTime", TimeValue(Seconds(TotalRunTimeSeconds)));
+    double stop =
+        i <= LeavingNodes ? stop_time->GetValue() : TotalRunTimeSeconds;
+    helper.SetAttribute("StopTime", TimeValue(Seconds(stop)));
     helper.Install(nodes.Get(i));
+    delivery_tracker.AddMember(user_prefix, 1.0, stop);
 
     ndn::FibHelper::AddRoute(nodes.Get(0), "/ndn/broadcast/sync", nodes.Get(i),
                              1);
@@ -123,20 +193,55 @@ int main(int argc, char* argv[]) {
 
     nodes.Get(i)->GetApplication(0)->TraceConnect("DataEvent", user_prefix,
                                                   MakeCallback(&DataEvent));
+    nodes.Get(i)->GetApplication(0)->TraceConnect("FetchEvent", user_prefix,
+                                                  MakeCallback(&FetchEvent));
   }
 
-  Simulator::Stop(Seconds(TotalRunTimeSeconds));
-
-  ndn::L3RateTracer::InstallAll("rate-trace.txt",
-                                Seconds(TotalRunTimeSeconds - 0.5));
+  if (LossBurstStart > 0.0) {
+    Simulator::Schedule(Seconds(LossBurstStart), &SetLossRate, rem,
+                        LossBurstRate);
+    Simulator::Schedule(Seconds(LossBurstStart + LossBurstDuration),
+                        &EndLossBurst, rem, LossRate);
+  }
 
-  Simulator::Run();
-  Simulator::Destroy();
+  Simulator::Stop(Seconds(TotalRunTimeSeconds));
 
   std::string file_name = "results/D" + LinkDelay + "N" + std::to_string(N);
   if (Synchronized) file_name += "Sync";
   if (LossRate > 0.0) file_name += "LR" + std::to_string(LossRate);
+  if (RetryPolicy != "fixed") file_name += "RP" + RetryPolicy;
+  if (SyncStrategy != "multicast") file_name += "SS" + SyncStrategy;
+  if (RandomSeed != 1) file_name += "RS" + std::to_string(RandomSeed);
   if (LeavingNodes > 0) file_name += "LN" + std::to_string(LeavingNodes);
+  if (LossBurstStart > 0.0) file_name += "LB" + std::to_string(LossBurstStart);
+  if (DataRate != 1.0) file_name += "DR" + std::to_string(DataRate);
+
+  if (SamplingPeriod > 0.0) {
+    ndn::L3RateTracer::InstallAll(file_name + "-rate-trace.txt",
+                                  Seconds(SamplingPeriod));
+    sampler.reset(new ndn::WindowedSampler(file_name + "-timeseries.txt",
+                                           Seconds(SamplingPeriod),
+                                           "/ndn/broadcast/sync"));
+    sampler->InstallAll();
+  } else {
+    ndn::L3RateTracer::InstallAll(file_name + "-rate-trace.txt",
+                                  Seconds(TotalRunTimeSeconds - 0.5));
+  }
+
+  metrics.InstallAll("/ndn/broadcast/sync");
+
+  ndn::TrafficClassTracer traffic_tracer(
+      file_name + "-traffic-classes.txt",
+      Seconds(SamplingPeriod > 0.0 ? SamplingPeriod
+                                   : TotalRunTimeSeconds - 0.5),
+      "/ndn/broadcast/sync");
+  traffic_tracer.InstallAll();
+
+  Simulator::Run();
+  Simulator::Destroy();
+
+  delivery_tracker.Finish(TotalRunTimeSeconds);
+
   std::fstream fs(file_name, std::ios_base::out | std::ios_base::trunc);
 
   int count = 0;
@@ -161,6 +266,18 @@ int main(int argc, char* argv[]) {
   std::cout << "Total number of data propagated is: " << count << std::endl;
   std::cout << "Average data propagation delay is: " << average_delay
             << " seconds." << std::endl;
+  std::cout << "Fetch delivery ratio (" << RetryPolicy
+            << " retry policy) is: " << fetch_stats.GetDeliveryRatio() << " ("
+            << fetch_stats.GetDelivered() << "/" << fetch_stats.GetAttempted()
+            << ", " << fetch_stats.GetRetransmissions()
+            << " retransmissions)" << std::endl;
+  std::cout << "Fetch delay p50/p99 is: "
+            << fetch_stats.GetDelayPercentile(0.5) << "/"
+            << fetch_stats.GetDelayPercentile(0.99) << " seconds."
+            << std::endl;
+  delivery_tracker.Report(std::cout);
+  metrics.Print(std::cout, delivery_tracker);
+  traffic_tracer.Report(std::cout, Seconds(TotalRunTimeSeconds));
 
   return 0;
 }